@@ -2,7 +2,68 @@
  * INCLUDES                                 *
  ********************************************/
 
+#include <string.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 #include "STX_ETX.h"
+#include "STX_ETX_CRC.h"
+
+/********************************************
+ * LOCAL #define CONSTANTS AND MACROS       *
+ ********************************************/
+
+#define STX_ETX_WORD_ONES   ((uint64_t)0x0101010101010101ULL) /** Byte-wise 0x01 pattern. */
+#define STX_ETX_WORD_HIGHS  ((uint64_t)0x8080808080808080ULL) /** Byte-wise 0x80 pattern. */
+
+/** @brief Check if any byte of 64-bit word is zero. */
+#define STX_ETX_WORD_HAS_ZERO(word) ((((word) - STX_ETX_WORD_ONES) & ~(word) & STX_ETX_WORD_HIGHS) != 0)
+
+/** @brief Count zero bytes of 64-bit word. */
+#define STX_ETX_WORD_COUNT_ZERO(word) \
+  ((size_t)__builtin_popcountll(~((((word) & ~STX_ETX_WORD_HIGHS) + ~STX_ETX_WORD_HIGHS) | (word) | ~STX_ETX_WORD_HIGHS)))
+
+/** @brief Byte classes of table driven decoder. */
+#define STX_ETX_CLASS_DATA         0  /** Not special byte. */
+#define STX_ETX_CLASS_STX          1  /** STX. */
+#define STX_ETX_CLASS_ETX          2  /** ETX. */
+#define STX_ETX_CLASS_DLE          3  /** DLE. */
+#define STX_ETX_CLASS_LAST         4
+
+/** @brief Actions of table driven decoder, which leave branch-free loop. */
+#define STX_ETX_ACTION_NONE        0  /** Byte is handled by transition. */
+#define STX_ETX_ACTION_START       1  /** Frame starts, CRC starts. */
+#define STX_ETX_ACTION_END         2  /** Frame ends (ETX), CRC bytes follow if enabled. */
+#define STX_ETX_ACTION_CRC_BYTE_0  3  /** CRC byte 0. */
+#define STX_ETX_ACTION_CRC_BYTE_1  4  /** CRC byte 1, frame is finished. */
+#define STX_ETX_ACTION_INV_CHAR    5  /** Invalid character. */
+
+#define STX_ETX_ENTRY_STATE_MASK   0x07  /** Next state bits of transition. */
+#define STX_ETX_ENTRY_EMIT         0x08  /** Byte is written to output. */
+#define STX_ETX_ENTRY_ACTION_SHIFT 4     /** Action bits of transition. */
+
+/** @brief Transition of table driven decoder. */
+#define STX_ETX_ENTRY(state, emit, action) \
+  (uint8_t)((state) | ((emit) ? STX_ETX_ENTRY_EMIT : 0) | ((action) << STX_ETX_ENTRY_ACTION_SHIFT))
+
+#ifdef STX_ETX_STATS
+/** @brief Add value to statistics counter of parser instance (single writer). */
+#define STX_ETX_STATS_ADD(p_instance, counter, value)                                       \
+  do                                                                                        \
+  {                                                                                         \
+    if (NULL != (p_instance)->p_stats)                                                      \
+    {                                                                                       \
+      uint64_t * p_counter = &(p_instance)->p_stats->counters.counter;                      \
+      __atomic_store_n(p_counter,                                                           \
+                       __atomic_load_n(p_counter, __ATOMIC_RELAXED) + (uint64_t)(value),    \
+                       __ATOMIC_RELAXED);                                                   \
+    }                                                                                       \
+  } while (0)
+#else
+#define STX_ETX_STATS_ADD(p_instance, counter, value) do {} while (0)
+#endif
 
 /********************************************
  * LOCAL FUNCTIONS PROTOTYPES               *
@@ -20,6 +81,157 @@
 static bool STX_ETX_Write(uint8_t * p_out, size_t out_len, size_t * p_index, uint8_t value);
 
 
+/** @brief Write decoded byte to output buffer.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in]      out_len    Output buffer length.
+ *  @param [in,out]  p_index    Write index.
+ *  @param [in]      value      Value to be written.
+ *
+ *  @return STX_ETX_Status_t CONTINUE, if written, TOO_LONG or OVERFLOW otherwise.
+ */
+static STX_ETX_Status_t STX_ETX_DecodeWrite(STX_ETX_t * p_instance,
+                                            uint8_t *   p_out,
+                                            size_t      out_len,
+                                            size_t *    p_index,
+                                            uint8_t     value);
+
+
+/** @brief Limit number of decoded bytes to room left in frame.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      len        Number of bytes to be decoded.
+ *
+ *  @return size_t Number of bytes, which may be decoded.
+ */
+static size_t STX_ETX_FrameRoom(STX_ETX_t const * p_instance, size_t len);
+
+
+/** @brief Check if byte is special (STX, ETX or DLE).
+ *
+ *  @param [in]      value    Value to be checked.
+ *
+ *  @return bool True, if value has to be escaped.
+ */
+static bool STX_ETX_IsSpecial(uint8_t value);
+
+
+
+/** @brief Count special bytes (STX, ETX and DLE).
+ *
+ *  @note Uses AVX2/SSE2 when enabled by compiler, 64-bit word count otherwise.
+ *
+ *  @param [in]      p_in     Pointer to input buffer.
+ *  @param [in]      in_len   Input buffer length.
+ *
+ *  @return size_t Number of special bytes.
+ */
+static size_t STX_ETX_CountSpecial(uint8_t const * p_in, size_t in_len);
+
+
+/** @brief Decode run of not special characters.
+ *
+ *  @note Copies bytes preceding next special byte at once. Output is moved,
+ *        so input and output buffers may overlap, if output does not lead input.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      p_in       Pointer to input buffer.
+ *  @param [in]      in_len     Input buffer length.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in]      out_len    Output buffer length.
+ *
+ *  @return size_t Number of bytes copied.
+ */
+static size_t STX_ETX_DecodeRun(STX_ETX_t *     p_instance,
+                                uint8_t const * p_in,
+                                size_t          in_len,
+                                uint8_t *       p_out,
+                                size_t          out_len);
+
+
+/** @brief Encode run of not special characters.
+ *
+ *  @note Copies bytes preceding next special byte at once.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      p_in       Pointer to input buffer.
+ *  @param [in]      in_len     Input buffer length.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in]      out_len    Output buffer length.
+ *
+ *  @return size_t Number of bytes copied.
+ */
+static size_t STX_ETX_EncodeRun(STX_ETX_t *     p_instance,
+                                uint8_t const * p_in,
+                                size_t          in_len,
+                                uint8_t *       p_out,
+                                size_t          out_len);
+
+
+/** @brief Decode STX-ETX data until frame is finished or input is consumed.
+ *
+ *  @note Parser is reset, if frame is finished or error occurs.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      p_in       Pointer to input buffer.
+ *  @param [in]      in_len     Input buffer length.
+ *  @param [in,out]  p_in_index Read index.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in]      out_len    Output buffer length.
+ *  @param [in,out]  p_out_index Write index.
+ *
+ *  @return STX_ETX_Status_t.
+ */
+static STX_ETX_Status_t STX_ETX_DecodeFrame(STX_ETX_t *     p_instance,
+                                            uint8_t const * p_in,
+                                            size_t          in_len,
+                                            size_t *        p_in_index,
+                                            uint8_t *       p_out,
+                                            size_t          out_len,
+                                            size_t *        p_out_index);
+
+
+/** @brief Encode STX-ETX data without finishing frame.
+ *
+ *  @note Frame is started, if parser is idle.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      p_in       Pointer to input buffer.
+ *  @param [in]      in_len     Input buffer length.
+ *  @param [in,out]  p_in_index Read index.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in]      out_len    Output buffer length.
+ *  @param [in,out]  p_out_index Write index.
+ *
+ *  @return STX_ETX_Status_t CONTINUE, if input is consumed, OVERFLOW otherwise.
+ */
+static STX_ETX_Status_t STX_ETX_EncodeData(STX_ETX_t *     p_instance,
+                                           uint8_t const * p_in,
+                                           size_t          in_len,
+                                           size_t *        p_in_index,
+                                           uint8_t *       p_out,
+                                           size_t          out_len,
+                                           size_t *        p_out_index);
+
+
+/** @brief Finish encoding of frame (ETX and CRC).
+ *
+ *  @note Parser is reset, if frame is finished.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in]      out_len    Output buffer length.
+ *  @param [in,out]  p_out_index Write index.
+ *
+ *  @return STX_ETX_Status_t.
+ */
+static STX_ETX_Status_t STX_ETX_EncodeFinal(STX_ETX_t * p_instance,
+                                            uint8_t *   p_out,
+                                            size_t      out_len,
+                                            size_t *    p_out_index);
+
+
 /** @brief Decode CRC byte 0.
  *
  *  @param [in]      p_instance Pointer to parser instance.
@@ -197,84 +409,1049 @@ static STX_ETX_Status_t STX_ETX_EncodeStart(STX_ETX_t * p_instance,
                                            size_t *     p_index);
 
 
-/** @brief End encoding.
- *
- *  @param [in]      p_instance Pointer to parser instance.
- *  @param [out]     p_out      Pointer to output buffer.
- *  @param [in]      out_len    Output buffer length.
- *  @param [in,out]  p_index    Write index.
- *
- *  @return STX_ETX_Status_t.
- */
-static STX_ETX_Status_t STX_ETX_EncodeEnd(STX_ETX_t * p_instance,
-                                          uint8_t *       p_out,
-                                          size_t       out_len,
-                                          size_t *     p_index);
+/** @brief End encoding.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in]      out_len    Output buffer length.
+ *  @param [in,out]  p_index    Write index.
+ *
+ *  @return STX_ETX_Status_t.
+ */
+static STX_ETX_Status_t STX_ETX_EncodeEnd(STX_ETX_t * p_instance,
+                                          uint8_t *       p_out,
+                                          size_t       out_len,
+                                          size_t *     p_index);
+
+
+/** @brief Check if CRC is enable.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *
+ *  @return bool  True, when CRC is enable.
+ */
+static bool STX_ETX_IsCRCEnable(STX_ETX_t * p_instance);
+
+
+/** @brief Check if CRC is enable in configuration.
+ *
+ *  @param [in]      p_config   Pointer to parser configuration.
+ *
+ *  @return bool  True, when CRC is enable.
+ */
+static bool STX_ETX_IsConfigCRCEnable(STX_ETX_Config_t const * p_config);
+
+
+/** @brief Check if CRC covers decoded payload only.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *
+ *  @return bool  True, when CRC covers payload, false when it covers wire bytes.
+ */
+static bool STX_ETX_IsCRCPayload(STX_ETX_t * p_instance);
+
+
+/** @brief Initialize CRC.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *
+ *  @return void.
+ */
+static void STX_ETX_InitCRC(STX_ETX_t * p_instance);
+
+
+/** @brief Update CRC.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      value      New value.
+ *
+ *  @return void.
+ */
+static void STX_ETX_UpdateCRC(STX_ETX_t * p_instance, uint8_t value);
+
+
+/** @brief Update CRC with block of bytes.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      p_data     Pointer to new values.
+ *  @param [in]      len        Number of new values.
+ *
+ *  @return void.
+ */
+static void STX_ETX_UpdateCRCBlock(STX_ETX_t * p_instance, uint8_t const * p_data, size_t len);
+
+
+/** @brief Update CRC with byte, which is covered in wire mode only (STX, ETX, escape).
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      value      New value.
+ *
+ *  @return void.
+ */
+static void STX_ETX_UpdateWireCRC(STX_ETX_t * p_instance, uint8_t value);
+
+
+/** @brief Update CRC with block of bytes in wire mode only.
+ *
+ *  @note Payload mode covers the same bytes by one block update at the end.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      p_data     Pointer to new values.
+ *  @param [in]      len        Number of new values.
+ *
+ *  @return void.
+ */
+static void STX_ETX_UpdateWireCRCBlock(STX_ETX_t * p_instance, uint8_t const * p_data, size_t len);
+
+#ifdef STX_ETX_STATS
+/** @brief Count frame status in statistics.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      status     Decoding or encoding status.
+ *  @param [in]      is_encode  True, if status was returned by encoder.
+ *
+ *  @return void.
+ */
+static void STX_ETX_StatsStatus(STX_ETX_t * p_instance, STX_ETX_Status_t status, bool is_encode);
+#endif
+
+/********************************************
+ * LOCAL CONSTANTS                          *
+ ********************************************/
+
+/** @brief Byte classes. */
+static const uint8_t STX_ETX_Classes[256] =
+{
+  [STX] = STX_ETX_CLASS_STX,
+  [ETX] = STX_ETX_CLASS_ETX,
+  [DLE] = STX_ETX_CLASS_DLE,
+};
+
+/** @brief Transitions of table driven decoder. Invalid characters keep the state. */
+static const uint8_t STX_ETX_Transitions[][STX_ETX_CLASS_LAST] =
+{
+  [STX_ETX_STATE_IDLE] =
+  {
+    [STX_ETX_CLASS_DATA] = STX_ETX_ENTRY(STX_ETX_STATE_IDLE,        false, STX_ETX_ACTION_INV_CHAR),
+    [STX_ETX_CLASS_STX]  = STX_ETX_ENTRY(STX_ETX_STATE_STARTED,     false, STX_ETX_ACTION_START),
+    [STX_ETX_CLASS_ETX]  = STX_ETX_ENTRY(STX_ETX_STATE_IDLE,        false, STX_ETX_ACTION_INV_CHAR),
+    [STX_ETX_CLASS_DLE]  = STX_ETX_ENTRY(STX_ETX_STATE_IDLE,        false, STX_ETX_ACTION_INV_CHAR),
+  },
+  [STX_ETX_STATE_STARTED] =
+  {
+    [STX_ETX_CLASS_DATA] = STX_ETX_ENTRY(STX_ETX_STATE_STARTED,     true,  STX_ETX_ACTION_NONE),
+    [STX_ETX_CLASS_STX]  = STX_ETX_ENTRY(STX_ETX_STATE_STARTED,     false, STX_ETX_ACTION_INV_CHAR),
+    [STX_ETX_CLASS_ETX]  = STX_ETX_ENTRY(STX_ETX_STATE_CRC_BYTE_0,  false, STX_ETX_ACTION_END),
+    [STX_ETX_CLASS_DLE]  = STX_ETX_ENTRY(STX_ETX_STATE_DLE_LATCHED, false, STX_ETX_ACTION_NONE),
+  },
+  [STX_ETX_STATE_DLE_LATCHED] =
+  {
+    [STX_ETX_CLASS_DATA] = STX_ETX_ENTRY(STX_ETX_STATE_DLE_LATCHED, false, STX_ETX_ACTION_INV_CHAR),
+    [STX_ETX_CLASS_STX]  = STX_ETX_ENTRY(STX_ETX_STATE_STARTED,     true,  STX_ETX_ACTION_NONE),
+    [STX_ETX_CLASS_ETX]  = STX_ETX_ENTRY(STX_ETX_STATE_STARTED,     true,  STX_ETX_ACTION_NONE),
+    [STX_ETX_CLASS_DLE]  = STX_ETX_ENTRY(STX_ETX_STATE_STARTED,     true,  STX_ETX_ACTION_NONE),
+  },
+  [STX_ETX_STATE_CRC_BYTE_0] =
+  {
+    [STX_ETX_CLASS_DATA] = STX_ETX_ENTRY(STX_ETX_STATE_CRC_BYTE_1,  false, STX_ETX_ACTION_CRC_BYTE_0),
+    [STX_ETX_CLASS_STX]  = STX_ETX_ENTRY(STX_ETX_STATE_CRC_BYTE_1,  false, STX_ETX_ACTION_CRC_BYTE_0),
+    [STX_ETX_CLASS_ETX]  = STX_ETX_ENTRY(STX_ETX_STATE_CRC_BYTE_1,  false, STX_ETX_ACTION_CRC_BYTE_0),
+    [STX_ETX_CLASS_DLE]  = STX_ETX_ENTRY(STX_ETX_STATE_CRC_BYTE_1,  false, STX_ETX_ACTION_CRC_BYTE_0),
+  },
+  [STX_ETX_STATE_CRC_BYTE_1] =
+  {
+    [STX_ETX_CLASS_DATA] = STX_ETX_ENTRY(STX_ETX_STATE_IDLE,        false, STX_ETX_ACTION_CRC_BYTE_1),
+    [STX_ETX_CLASS_STX]  = STX_ETX_ENTRY(STX_ETX_STATE_IDLE,        false, STX_ETX_ACTION_CRC_BYTE_1),
+    [STX_ETX_CLASS_ETX]  = STX_ETX_ENTRY(STX_ETX_STATE_IDLE,        false, STX_ETX_ACTION_CRC_BYTE_1),
+    [STX_ETX_CLASS_DLE]  = STX_ETX_ENTRY(STX_ETX_STATE_IDLE,        false, STX_ETX_ACTION_CRC_BYTE_1),
+  },
+  [STX_ETX_STATE_DISCARD] =
+  {
+    [STX_ETX_CLASS_DATA] = STX_ETX_ENTRY(STX_ETX_STATE_DISCARD,     false, STX_ETX_ACTION_NONE),
+    [STX_ETX_CLASS_STX]  = STX_ETX_ENTRY(STX_ETX_STATE_STARTED,     false, STX_ETX_ACTION_START),
+    [STX_ETX_CLASS_ETX]  = STX_ETX_ENTRY(STX_ETX_STATE_DISCARD,     false, STX_ETX_ACTION_NONE),
+    [STX_ETX_CLASS_DLE]  = STX_ETX_ENTRY(STX_ETX_STATE_DISCARD,     false, STX_ETX_ACTION_NONE),
+  },
+};
+
+/********************************************
+ * EXPORTED FUNCTION DEFINITIONS            *
+ ********************************************/
+
+void STX_ETX_Init(STX_ETX_t *                 p_instance,
+                  STX_ETX_Config_t const *    p_config)
+{
+  p_instance->p_config = p_config;
+#ifdef STX_ETX_STATS
+  p_instance->p_stats  = NULL;
+#endif
+
+  STX_ETX_Reset(p_instance);
+}
+
+void STX_ETX_Reset(STX_ETX_t * p_instance)
+{
+  p_instance->state     = STX_ETX_STATE_IDLE;
+  p_instance->frame_len = 0;
+  STX_ETX_InitCRC(p_instance);
+}
+
+bool STX_ETX_IsError(STX_ETX_Status_t status)
+{
+  return status >= STX_ETX_STATUS_ERR_BASE;
+}
+
+size_t STX_ETX_FindSpecial(uint8_t const * p_in, size_t in_len)
+{
+  size_t index = 0;
+
+#if defined(__AVX2__)
+  __m256i const stx_etx_256 = _mm256_set1_epi8(STX | ETX);
+  __m256i const dle_256     = _mm256_set1_epi8(DLE);
+  __m256i const one_256     = _mm256_set1_epi8(STX ^ ETX);
+
+  for (; (index + sizeof(__m256i)) <= in_len; index += sizeof(__m256i))
+  {
+    __m256i  block = _mm256_loadu_si256((__m256i const *)&p_in[index]);
+    __m256i  match = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_or_si256(block, one_256), stx_etx_256),
+                                     _mm256_cmpeq_epi8(block, dle_256));
+    uint32_t mask  = (uint32_t)_mm256_movemask_epi8(match);
+
+    if (0 != mask)
+    {
+      return index + (size_t)__builtin_ctz(mask);
+    }
+  }
+#endif
+
+#if defined(__SSE2__)
+  __m128i const stx_etx_128 = _mm_set1_epi8(STX | ETX);
+  __m128i const dle_128     = _mm_set1_epi8(DLE);
+  __m128i const one_128     = _mm_set1_epi8(STX ^ ETX);
+
+  for (; (index + sizeof(__m128i)) <= in_len; index += sizeof(__m128i))
+  {
+    __m128i  block = _mm_loadu_si128((__m128i const *)&p_in[index]);
+    __m128i  match = _mm_or_si128(_mm_cmpeq_epi8(_mm_or_si128(block, one_128), stx_etx_128),
+                                  _mm_cmpeq_epi8(block, dle_128));
+    uint32_t mask  = (uint32_t)_mm_movemask_epi8(match);
+
+    if (0 != mask)
+    {
+      return index + (size_t)__builtin_ctz(mask);
+    }
+  }
+#else
+  for (; (index + sizeof(uint64_t)) <= in_len; index += sizeof(uint64_t))
+  {
+    uint64_t word;
+    memcpy(&word, &p_in[index], sizeof(word));
+
+    if (STX_ETX_WORD_HAS_ZERO(word ^ (STX_ETX_WORD_ONES * STX))
+     || STX_ETX_WORD_HAS_ZERO(word ^ (STX_ETX_WORD_ONES * ETX))
+     || STX_ETX_WORD_HAS_ZERO(word ^ (STX_ETX_WORD_ONES * DLE)))
+    {
+      break;
+    }
+  }
+#endif
+
+  for (; index < in_len; index++)
+  {
+    if (STX_ETX_IsSpecial(p_in[index]))
+    {
+      break;
+    }
+  }
+  return index;
+}
+
+#ifdef STX_ETX_STATS
+void STX_ETX_StatsAttach(STX_ETX_t * p_instance, STX_ETX_Stats_t * p_stats)
+{
+  if (NULL != p_stats)
+  {
+    memset(p_stats, 0, sizeof(*p_stats));
+  }
+  p_instance->p_stats = p_stats;
+}
+
+void STX_ETX_StatsSnapshot(STX_ETX_Stats_t const * p_stats, STX_ETX_StatsCounters_t * p_counters)
+{
+  uint64_t const * p_counter = (uint64_t const *)&p_stats->counters;
+  uint64_t const * p_base    = (uint64_t const *)&p_stats->base;
+  uint64_t *       p_result  = (uint64_t *)p_counters;
+
+  for (size_t index = 0; index < sizeof(STX_ETX_StatsCounters_t) / sizeof(uint64_t); index++)
+  {
+    p_result[index] = __atomic_load_n(&p_counter[index], __ATOMIC_RELAXED) - p_base[index];
+  }
+}
+
+void STX_ETX_StatsReset(STX_ETX_Stats_t * p_stats)
+{
+  uint64_t const * p_counter = (uint64_t const *)&p_stats->counters;
+  uint64_t *       p_base    = (uint64_t *)&p_stats->base;
+
+  for (size_t index = 0; index < sizeof(STX_ETX_StatsCounters_t) / sizeof(uint64_t); index++)
+  {
+    p_base[index] = __atomic_load_n(&p_counter[index], __ATOMIC_RELAXED);
+  }
+}
+#endif
+
+STX_ETX_Status_t STX_ETX_Decode(STX_ETX_t *     p_instance,
+                                uint8_t const * p_in,
+                                size_t *        p_in_len,
+                                uint8_t *       p_out,
+                                size_t *        p_out_len)
+{
+  size_t           in_index  = 0;
+  size_t           out_index = 0;
+  STX_ETX_Status_t status    = STX_ETX_DecodeFrame(p_instance,
+                                                   p_in,
+                                                   *p_in_len,
+                                                   &in_index,
+                                                   p_out,
+                                                   *p_out_len,
+                                                   &out_index);
+
+  *p_in_len  = in_index;
+  *p_out_len = out_index;
+  return status;
+}
+
+STX_ETX_Status_t STX_ETX_DecodeResync(STX_ETX_t *        p_instance,
+                                     uint8_t const *    p_in,
+                                     size_t *           p_in_len,
+                                     uint8_t *          p_out,
+                                     size_t *           p_out_len,
+                                     STX_ETX_Resync_t * p_resync)
+{
+  STX_ETX_Status_t status    = STX_ETX_STATUS_CONTINUE;
+  size_t           in_index  = 0;
+  size_t           out_index = 0;
+
+  while (in_index < *p_in_len)
+  {
+    if ((STX_ETX_STATE_IDLE == p_instance->state) || (STX_ETX_STATE_DISCARD == p_instance->state))
+    {
+      uint8_t const * p_stx    = memchr(&p_in[in_index], STX, *p_in_len - in_index);
+      size_t          skip_len = (NULL != p_stx) ? (size_t)(p_stx - &p_in[in_index]) : (*p_in_len - in_index);
+
+      p_resync->skipped_len += skip_len;
+      in_index              += skip_len;
+      STX_ETX_STATS_ADD(p_instance, idle_discarded, skip_len);
+
+      if (in_index == *p_in_len)
+      {
+        break;
+      }
+      p_instance->state = STX_ETX_STATE_IDLE;
+    }
+
+    status = STX_ETX_DecodeFrame(p_instance, p_in, *p_in_len, &in_index, p_out, *p_out_len, &out_index);
+
+    if (!STX_ETX_IsError(status))
+    {
+      break;
+    }
+
+    if (STX_ETX_STATUS_INV_CRC == status)
+    {
+      p_resync->inv_crc_cnt++;
+    }
+    else if (STX_ETX_STATUS_TOO_LONG == status)
+    {
+      p_resync->too_long_cnt++;
+    }
+    else
+    {
+      p_resync->inv_char_cnt++;
+
+      if (STX == p_in[in_index - 1])
+      {
+        in_index--;
+      }
+    }
+
+    status    = STX_ETX_STATUS_CONTINUE;
+    out_index = 0;
+  }
+
+  *p_in_len  = in_index;
+  *p_out_len = out_index;
+  return status;
+}
+
+STX_ETX_Status_t STX_ETX_DecodeBatch(STX_ETX_t *       p_instance,
+                                    uint8_t const *   p_in,
+                                    size_t *          p_in_len,
+                                    uint8_t *         p_out,
+                                    size_t *          p_out_len,
+                                    STX_ETX_Frame_t * p_frames,
+                                    size_t *          p_frames_cnt)
+{
+  STX_ETX_Status_t status       = STX_ETX_STATUS_CONTINUE;
+  size_t           in_index     = 0;
+  size_t           out_index    = 0;
+  size_t           frames_index = 0;
+
+  while (in_index < *p_in_len)
+  {
+    if (frames_index == *p_frames_cnt)
+    {
+      status = STX_ETX_STATUS_OVERFLOW;
+      break;
+    }
+
+    size_t frame_offset = out_index;
+
+    status = STX_ETX_DecodeFrame(p_instance, p_in, *p_in_len, &in_index, p_out, *p_out_len, &out_index);
+
+    if (STX_ETX_IsError(status))
+    {
+      out_index = frame_offset;
+    }
+
+    p_frames[frames_index].offset = frame_offset;
+    p_frames[frames_index].len    = out_index - frame_offset;
+    p_frames[frames_index].status = status;
+    frames_index++;
+
+    if (STX_ETX_STATUS_OVERFLOW == status)
+    {
+      break;
+    }
+  }
+
+  *p_in_len     = in_index;
+  *p_out_len    = out_index;
+  *p_frames_cnt = frames_index;
+  return status;
+}
+
+STX_ETX_Status_t STX_ETX_DecodeInPlace(STX_ETX_t *       p_instance,
+                                      uint8_t *         p_buf,
+                                      size_t *          p_buf_len,
+                                      STX_ETX_Frame_t * p_frames,
+                                      size_t *          p_frames_cnt)
+{
+  size_t out_len = *p_buf_len;
+
+  return STX_ETX_DecodeBatch(p_instance, p_buf, p_buf_len, p_buf, &out_len, p_frames, p_frames_cnt);
+}
+
+STX_ETX_Status_t STX_ETX_DecodeTable(STX_ETX_t *     p_instance,
+                                     uint8_t const * p_in,
+                                     size_t *        p_in_len,
+                                     uint8_t *       p_out,
+                                     size_t *        p_out_len)
+{
+  STX_ETX_Status_t status    = STX_ETX_STATUS_CONTINUE;
+  STX_ETX_State_t  state     = p_instance->state;
+  size_t           in_len    = *p_in_len;
+  size_t           out_len   = *p_out_len;
+  size_t           in_index  = 0;
+  size_t           out_index = 0;
+  size_t           crc_index = 0;  /* Start of frame bytes not included in CRC yet. */
+  uint8_t          value     = 0;
+  uint8_t          entry;
+  bool             crc_out   = STX_ETX_IsCRCPayload(p_instance);  /* CRC covers output instead of input. */
+  uint8_t const *  p_crc     = crc_out ? p_out : p_in;
+#ifdef STX_ETX_STATS
+  size_t           escapes   = 0;
+  size_t           discarded = 0;
+#endif
+
+  while ((STX_ETX_STATUS_CONTINUE == status) && (in_index < in_len))
+  {
+    size_t run_len = in_len - in_index;
+
+    if (run_len > out_len - out_index)
+    {
+      run_len = out_len - out_index;
+    }
+    run_len = STX_ETX_FrameRoom(p_instance, run_len);
+
+    if (0 == run_len)
+    {
+      /* Output buffer or frame is full, only bytes, which are not written, may be processed. */
+      value = p_in[in_index];
+      entry = STX_ETX_Transitions[state][STX_ETX_Classes[value]];
+
+      if (0 != (entry & STX_ETX_ENTRY_EMIT))
+      {
+        if (0 == STX_ETX_FrameRoom(p_instance, 1))
+        {
+          in_index++;
+          status = STX_ETX_STATUS_TOO_LONG;
+        }
+        else
+        {
+          status = STX_ETX_STATUS_OVERFLOW;
+        }
+        break;
+      }
+
+#ifdef STX_ETX_STATS
+      discarded += (STX_ETX_STATE_DISCARD == state) & (STX_ETX_STATE_DISCARD == (entry & STX_ETX_ENTRY_STATE_MASK));
+#endif
+      in_index++;
+      state = (STX_ETX_State_t)(entry & STX_ETX_ENTRY_STATE_MASK);
+    }
+    else
+    {
+      /* At most run_len bytes are written, so every byte is stored and kept if emitted. */
+      size_t run_end   = in_index + run_len;
+      size_t run_start = out_index;
+
+      do
+      {
+        value = p_in[in_index++];
+        entry = STX_ETX_Transitions[state][STX_ETX_Classes[value]];
+
+#ifdef STX_ETX_STATS
+        escapes   += (STX_ETX_STATE_DLE_LATCHED == state) & ((entry & STX_ETX_ENTRY_EMIT) >> 3);
+        discarded += (STX_ETX_STATE_DISCARD == state) & (STX_ETX_STATE_DISCARD == (entry & STX_ETX_ENTRY_STATE_MASK));
+#endif
+        p_out[out_index] = value;
+        out_index       += (entry & STX_ETX_ENTRY_EMIT) >> 3;
+        state            = (STX_ETX_State_t)(entry & STX_ETX_ENTRY_STATE_MASK);
+      }
+      while ((in_index < run_end) && (entry < (1 << STX_ETX_ENTRY_ACTION_SHIFT)));
+
+      p_instance->frame_len += out_index - run_start;
+    }
+
+    switch (entry >> STX_ETX_ENTRY_ACTION_SHIFT)
+    {
+      case STX_ETX_ACTION_NONE:
+        break;
+
+      case STX_ETX_ACTION_START:
+        crc_index = crc_out ? out_index : (in_index - 1);
+        break;
+
+      case STX_ETX_ACTION_END:
+        STX_ETX_UpdateCRCBlock(p_instance, &p_crc[crc_index], (crc_out ? out_index : in_index) - crc_index);
+
+        if (!STX_ETX_IsCRCEnable(p_instance))
+        {
+          status = STX_ETX_STATUS_DONE;
+        }
+        break;
+
+      case STX_ETX_ACTION_CRC_BYTE_0:
+        p_instance->crc16 = value;
+        break;
+
+      case STX_ETX_ACTION_CRC_BYTE_1:
+        p_instance->crc16 |= (uint16_t)value << 8;
+        status = (p_instance->crc16 != p_instance->computed_crc16) ? STX_ETX_STATUS_INV_CRC : STX_ETX_STATUS_DONE;
+        break;
+
+      default:
+        if (STX_ETX_STATE_IDLE == state)
+        {
+          STX_ETX_STATS_ADD(p_instance, idle_discarded, 1);
+        }
+        status = STX_ETX_STATUS_INV_CHAR;
+        break;
+    }
+  }
+
+  if ((STX_ETX_STATUS_OVERFLOW != status) && (STX_ETX_STATUS_CONTINUE != status))
+  {
+    STX_ETX_Reset(p_instance);
+
+    if (STX_ETX_STATUS_TOO_LONG == status)
+    {
+      p_instance->state = STX_ETX_STATE_DISCARD;
+    }
+  }
+  else
+  {
+    size_t crc_end = crc_out ? out_index : in_index;
+
+    if (((STX_ETX_STATE_STARTED == state) || (STX_ETX_STATE_DLE_LATCHED == state)) && (crc_index != crc_end))
+    {
+      STX_ETX_UpdateCRCBlock(p_instance, &p_crc[crc_index], crc_end - crc_index);
+    }
+    p_instance->state = state;
+  }
+
+  STX_ETX_STATS_ADD(p_instance, escapes_decoded, escapes);
+  STX_ETX_STATS_ADD(p_instance, idle_discarded, discarded);
+  STX_ETX_STATS_ADD(p_instance, payload_decoded, out_index);
+#ifdef STX_ETX_STATS
+  STX_ETX_StatsStatus(p_instance, status, false);
+#endif
+
+  *p_in_len  = in_index;
+  *p_out_len = out_index;
+  return status;
+}
+
+STX_ETX_Status_t STX_ETX_DecodeView(STX_ETX_t *      p_instance,
+                                   uint8_t const *  p_in,
+                                   size_t *         p_in_len,
+                                   uint8_t *        p_out,
+                                   size_t *         p_out_len,
+                                   uint8_t const ** pp_data,
+                                   size_t *         p_data_len)
+{
+  if ((STX_ETX_STATE_IDLE == p_instance->state) && (0 < *p_in_len) && (STX == p_in[0]))
+  {
+    size_t etx_index = 1 + STX_ETX_FindSpecial(&p_in[1], *p_in_len - 1);
+    size_t frame_len = etx_index + 1;
+
+    if (STX_ETX_IsCRCEnable(p_instance))
+    {
+      frame_len += sizeof(uint16_t);
+    }
+
+    if ((etx_index < *p_in_len) && (ETX == p_in[etx_index]) && (frame_len <= *p_in_len) &&
+        (etx_index - 1 == STX_ETX_FrameRoom(p_instance, etx_index - 1)))
+    {
+      STX_ETX_Status_t status = STX_ETX_STATUS_DONE;
+
+      if (STX_ETX_IsCRCEnable(p_instance))
+      {
+        if (STX_ETX_IsCRCPayload(p_instance))
+        {
+          STX_ETX_UpdateCRCBlock(p_instance, &p_in[1], etx_index - 1);
+        }
+        else
+        {
+          STX_ETX_UpdateCRCBlock(p_instance, p_in, etx_index + 1);
+        }
+
+        uint16_t crc16 = (uint16_t)p_in[etx_index + 1] | ((uint16_t)p_in[etx_index + 2] << 8);
+        if (crc16 != p_instance->computed_crc16)
+        {
+          status = STX_ETX_STATUS_INV_CRC;
+        }
+      }
+
+      STX_ETX_Reset(p_instance);
+      STX_ETX_STATS_ADD(p_instance, payload_decoded, etx_index - 1);
+#ifdef STX_ETX_STATS
+      STX_ETX_StatsStatus(p_instance, status, false);
+#endif
+
+      *p_in_len   = frame_len;
+      *p_out_len  = 0;
+      *pp_data    = &p_in[1];
+      *p_data_len = etx_index - 1;
+      return status;
+    }
+  }
+
+  STX_ETX_Status_t status = STX_ETX_Decode(p_instance, p_in, p_in_len, p_out, p_out_len);
+
+  *pp_data    = p_out;
+  *p_data_len = *p_out_len;
+  return status;
+}
+
+
+size_t STX_ETX_EncodedSize(STX_ETX_Config_t const * p_config,
+                           uint8_t const *          p_in,
+                           size_t                   in_len)
+{
+  STX_ETX_Span_t span = {p_in, in_len};
+
+  return STX_ETX_EncodedSizeV(p_config, &span, 1);
+}
+
+size_t STX_ETX_EncodedSizeV(STX_ETX_Config_t const * p_config,
+                            STX_ETX_Span_t const *   p_spans,
+                            size_t                   spans_cnt)
+{
+  size_t size = sizeof(uint8_t) + sizeof(uint8_t);
+
+  if (STX_ETX_IsConfigCRCEnable(p_config))
+  {
+    size += sizeof(uint16_t);
+  }
+
+  for (size_t span_index = 0; span_index < spans_cnt; span_index++)
+  {
+    size += p_spans[span_index].len + STX_ETX_CountSpecial(p_spans[span_index].p_data, p_spans[span_index].len);
+  }
+  return size;
+}
+
+STX_ETX_Status_t STX_ETX_Encode(STX_ETX_t *     p_instance,
+                                uint8_t const * p_in,
+                                size_t *        p_in_len,
+                                uint8_t *       p_out,
+                                size_t *        p_out_len)
+{
+  size_t           in_index  = 0;
+  size_t           out_index = 0;
+  STX_ETX_Status_t status    = STX_ETX_EncodeData(p_instance,
+                                                  p_in,
+                                                  *p_in_len,
+                                                  &in_index,
+                                                  p_out,
+                                                  *p_out_len,
+                                                  &out_index);
+
+  if (STX_ETX_STATUS_CONTINUE == status)
+  {
+    status = STX_ETX_EncodeFinal(p_instance, p_out, *p_out_len, &out_index);
+  }
+
+  *p_in_len  = in_index;
+  *p_out_len = out_index;
+  return status;
+}
+
+STX_ETX_Status_t STX_ETX_EncodeBegin(STX_ETX_t * p_instance,
+                                     uint8_t *   p_out,
+                                     size_t *    p_out_len)
+{
+  size_t in_len = 0;
+
+  return STX_ETX_EncodeAppend(p_instance, NULL, &in_len, p_out, p_out_len);
+}
+
+STX_ETX_Status_t STX_ETX_EncodeAppend(STX_ETX_t *     p_instance,
+                                      uint8_t const * p_in,
+                                      size_t *        p_in_len,
+                                      uint8_t *       p_out,
+                                      size_t *        p_out_len)
+{
+  size_t           in_index  = 0;
+  size_t           out_index = 0;
+  STX_ETX_Status_t status    = STX_ETX_EncodeData(p_instance,
+                                                  p_in,
+                                                  *p_in_len,
+                                                  &in_index,
+                                                  p_out,
+                                                  *p_out_len,
+                                                  &out_index);
+
+  *p_in_len  = in_index;
+  *p_out_len = out_index;
+  return status;
+}
+
+STX_ETX_Status_t STX_ETX_EncodeFinish(STX_ETX_t * p_instance,
+                                      uint8_t *   p_out,
+                                      size_t *    p_out_len)
+{
+  size_t           in_index  = 0;
+  size_t           out_index = 0;
+  STX_ETX_Status_t status    = STX_ETX_EncodeData(p_instance,
+                                                  NULL,
+                                                  0,
+                                                  &in_index,
+                                                  p_out,
+                                                  *p_out_len,
+                                                  &out_index);
+
+  if (STX_ETX_STATUS_CONTINUE == status)
+  {
+    status = STX_ETX_EncodeFinal(p_instance, p_out, *p_out_len, &out_index);
+  }
+
+  *p_out_len = out_index;
+  return status;
+}
+
+STX_ETX_Status_t STX_ETX_EncodeV(STX_ETX_t *            p_instance,
+                                 STX_ETX_Span_t const * p_spans,
+                                 size_t                 spans_cnt,
+                                 size_t *               p_in_offset,
+                                 uint8_t *              p_out,
+                                 size_t *               p_out_len)
+{
+  size_t           in_index  = 0;
+  size_t           out_index = 0;
+  size_t           skip_len  = *p_in_offset;
+  STX_ETX_Status_t status    = STX_ETX_EncodeData(p_instance,
+                                                  NULL,
+                                                  0,
+                                                  &in_index,
+                                                  p_out,
+                                                  *p_out_len,
+                                                  &out_index);
+
+  for (size_t span_index = 0; (span_index < spans_cnt) && (STX_ETX_STATUS_CONTINUE == status); span_index++)
+  {
+    STX_ETX_Span_t const * p_span = &p_spans[span_index];
+
+    if (skip_len >= p_span->len)
+    {
+      skip_len -= p_span->len;
+      continue;
+    }
+
+    size_t start_index = skip_len;
+
+    in_index = skip_len;
+    skip_len = 0;
+    status   = STX_ETX_EncodeData(p_instance,
+                                  p_span->p_data,
+                                  p_span->len,
+                                  &in_index,
+                                  p_out,
+                                  *p_out_len,
+                                  &out_index);
+
+    *p_in_offset += in_index - start_index;
+  }
+
+  if (STX_ETX_STATUS_CONTINUE == status)
+  {
+    status = STX_ETX_EncodeFinal(p_instance, p_out, *p_out_len, &out_index);
+  }
+
+  *p_out_len = out_index;
+  return status;
+}
+
+STX_ETX_Status_t STX_ETX_EncodeBatch(STX_ETX_t *            p_instance,
+                                     STX_ETX_Span_t const * p_msgs,
+                                     size_t *               p_msgs_cnt,
+                                     uint8_t *              p_out,
+                                     size_t *               p_out_len,
+                                     STX_ETX_Frame_t *      p_frames)
+{
+  STX_ETX_Status_t status    = STX_ETX_STATUS_DONE;
+  size_t           out_index = 0;
+  size_t           msg_index = 0;
+  size_t           tail_len  = sizeof(uint8_t) + sizeof(uint8_t);
+
+  if (STX_ETX_IsCRCEnable(p_instance))
+  {
+    tail_len += sizeof(uint16_t);
+  }
+
+  for (; msg_index < *p_msgs_cnt; msg_index++)
+  {
+    STX_ETX_Span_t const * p_msg     = &p_msgs[msg_index];
+    size_t                 room      = *p_out_len - out_index;
+    size_t                 in_index  = 0;
+    size_t                 out_start = out_index;
+
+    /* Exact size is computed only, when frame with every byte escaped may not fit. */
+    if ((room < tail_len) || ((room - tail_len) / 2 < p_msg->len))
+    {
+      if (STX_ETX_EncodedSize(p_instance->p_config, p_msg->p_data, p_msg->len) > room)
+      {
+        status = STX_ETX_STATUS_OVERFLOW;
+        break;
+      }
+    }
+
+    status = STX_ETX_EncodeData(p_instance, p_msg->p_data, p_msg->len, &in_index, p_out, *p_out_len, &out_index);
 
+    if (STX_ETX_STATUS_CONTINUE == status)
+    {
+      status = STX_ETX_EncodeFinal(p_instance, p_out, *p_out_len, &out_index);
+    }
 
-/** @brief Check if CRC is enable.
- *
- *  @param [in]      p_instance Pointer to parser instance.
- *
- *  @return bool  True, when CRC is enable.
- */
-static bool STX_ETX_IsCRCEnable(STX_ETX_t * p_instance);
+    p_frames[msg_index].offset = out_start;
+    p_frames[msg_index].len    = out_index - out_start;
+    p_frames[msg_index].status = status;
+  }
 
+  *p_msgs_cnt = msg_index;
+  *p_out_len  = out_index;
+  return status;
+}
 
-/** @brief Initialize CRC.
- *
- *  @param [in]      p_instance Pointer to parser instance.
- *
- *  @return void.
- */
-static void STX_ETX_InitCRC(STX_ETX_t * p_instance);
+/********************************************
+ * LOCAL FUNCTION DEFINITIONS               *
+ *******************************************/
 
+static bool STX_ETX_Write(uint8_t * p_out, size_t out_len, size_t * p_index, uint8_t value)
+{
+  if (*p_index < out_len)
+  {
+    p_out[(*p_index)++] = value;
+    return true;
+  }
+  return false;
+}
 
-/** @brief Update CRC.
- *
- *  @param [in]      p_instance Pointer to parser instance.
- *  @param [in]      value      New value.
- *
- *  @return void.
- */
-static void STX_ETX_UpdateCRC(STX_ETX_t * p_instance, uint8_t value);
+static STX_ETX_Status_t STX_ETX_DecodeWrite(STX_ETX_t * p_instance,
+                                            uint8_t *   p_out,
+                                            size_t      out_len,
+                                            size_t *    p_index,
+                                            uint8_t     value)
+{
+  if (0 == STX_ETX_FrameRoom(p_instance, 1))
+  {
+    return STX_ETX_STATUS_TOO_LONG;
+  }
 
-/********************************************
- * EXPORTED FUNCTION DEFINITIONS            *
- ********************************************/
+  if (!STX_ETX_Write(p_out, out_len, p_index, value))
+  {
+    return STX_ETX_STATUS_OVERFLOW;
+  }
 
-void STX_ETX_Init(STX_ETX_t *                 p_instance,
-                  STX_ETX_Config_t const *    p_config)
+  p_instance->frame_len++;
+  return STX_ETX_STATUS_CONTINUE;
+}
+
+static size_t STX_ETX_FrameRoom(STX_ETX_t const * p_instance, size_t len)
 {
-  p_instance->p_config = p_config;
+  size_t max_frame_len = p_instance->p_config->max_frame_len;
 
-  STX_ETX_Reset(p_instance);
+  if ((0 != max_frame_len) && (len > max_frame_len - p_instance->frame_len))
+  {
+    return max_frame_len - p_instance->frame_len;
+  }
+  return len;
 }
 
-void STX_ETX_Reset(STX_ETX_t * p_instance)
+static bool STX_ETX_IsSpecial(uint8_t value)
 {
-  p_instance->state = STX_ETX_STATE_IDLE;
-  STX_ETX_InitCRC(p_instance);
+  return (STX == value) || (ETX == value) || (DLE == value);
 }
 
-bool STX_ETX_IsError(STX_ETX_Status_t status)
+static size_t STX_ETX_CountSpecial(uint8_t const * p_in, size_t in_len)
 {
-  return status >= STX_ETX_STATUS_ERR_BASE;
+  size_t index = 0;
+  size_t count = 0;
+
+#if defined(__AVX2__)
+  __m256i const stx_etx_256 = _mm256_set1_epi8(STX | ETX);
+  __m256i const dle_256     = _mm256_set1_epi8(DLE);
+  __m256i const one_256     = _mm256_set1_epi8(STX ^ ETX);
+
+  for (; (index + sizeof(__m256i)) <= in_len; index += sizeof(__m256i))
+  {
+    __m256i block = _mm256_loadu_si256((__m256i const *)&p_in[index]);
+    __m256i match = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_or_si256(block, one_256), stx_etx_256),
+                                    _mm256_cmpeq_epi8(block, dle_256));
+
+    count += (size_t)__builtin_popcount((uint32_t)_mm256_movemask_epi8(match));
+  }
+#endif
+
+#if defined(__SSE2__)
+  __m128i const stx_etx_128 = _mm_set1_epi8(STX | ETX);
+  __m128i const dle_128     = _mm_set1_epi8(DLE);
+  __m128i const one_128     = _mm_set1_epi8(STX ^ ETX);
+
+  for (; (index + sizeof(__m128i)) <= in_len; index += sizeof(__m128i))
+  {
+    __m128i block = _mm_loadu_si128((__m128i const *)&p_in[index]);
+    __m128i match = _mm_or_si128(_mm_cmpeq_epi8(_mm_or_si128(block, one_128), stx_etx_128),
+                                 _mm_cmpeq_epi8(block, dle_128));
+
+    count += (size_t)__builtin_popcount((uint32_t)_mm_movemask_epi8(match));
+  }
+#else
+  for (; (index + sizeof(uint64_t)) <= in_len; index += sizeof(uint64_t))
+  {
+    uint64_t word;
+    memcpy(&word, &p_in[index], sizeof(word));
+
+    count += STX_ETX_WORD_COUNT_ZERO(word ^ (STX_ETX_WORD_ONES * STX))
+           + STX_ETX_WORD_COUNT_ZERO(word ^ (STX_ETX_WORD_ONES * ETX))
+           + STX_ETX_WORD_COUNT_ZERO(word ^ (STX_ETX_WORD_ONES * DLE));
+  }
+#endif
+
+  for (; index < in_len; index++)
+  {
+    if (STX_ETX_IsSpecial(p_in[index]))
+    {
+      count++;
+    }
+  }
+  return count;
 }
 
-STX_ETX_Status_t STX_ETX_Decode(STX_ETX_t *     p_instance,
+static size_t STX_ETX_DecodeRun(STX_ETX_t *     p_instance,
                                 uint8_t const * p_in,
-                                size_t *        p_in_len,
+                                size_t          in_len,
                                 uint8_t *       p_out,
-                                size_t *        p_out_len)
+                                size_t          out_len)
+{
+  size_t run_len = STX_ETX_FindSpecial(p_in, STX_ETX_FrameRoom(p_instance, (in_len < out_len) ? in_len : out_len));
+
+  if (0 != run_len)
+  {
+    STX_ETX_UpdateCRCBlock(p_instance, p_in, run_len);
+    memmove(p_out, p_in, run_len);
+    p_instance->frame_len += run_len;
+  }
+  return run_len;
+}
+
+static size_t STX_ETX_EncodeRun(STX_ETX_t *     p_instance,
+                                uint8_t const * p_in,
+                                size_t          in_len,
+                                uint8_t *       p_out,
+                                size_t          out_len)
+{
+  size_t run_len = STX_ETX_FindSpecial(p_in, (in_len < out_len) ? in_len : out_len);
+
+  if (0 != run_len)
+  {
+    memcpy(p_out, p_in, run_len);
+    STX_ETX_UpdateWireCRCBlock(p_instance, p_in, run_len);
+  }
+  return run_len;
+}
+
+static STX_ETX_Status_t STX_ETX_DecodeFrame(STX_ETX_t *     p_instance,
+                                            uint8_t const * p_in,
+                                            size_t          in_len,
+                                            size_t *        p_in_index,
+                                            uint8_t *       p_out,
+                                            size_t          out_len,
+                                            size_t *        p_out_index)
 {
   STX_ETX_Status_t status    = STX_ETX_STATUS_CONTINUE;
-  size_t           in_index  = 0;
-  size_t           out_index = 0;
+  size_t           in_index  = *p_in_index;
+  size_t           out_index = *p_out_index;
 
-  while ((in_index < *p_in_len) && (STX_ETX_STATUS_CONTINUE == status))
+  while ((in_index < in_len) && (STX_ETX_STATUS_CONTINUE == status))
   {
+    if (STX_ETX_STATE_DISCARD == p_instance->state)
+    {
+      uint8_t const * p_stx    = memchr(&p_in[in_index], STX, in_len - in_index);
+      size_t          skip_len = (NULL != p_stx) ? (size_t)(p_stx - &p_in[in_index]) : (in_len - in_index);
+
+      in_index += skip_len;
+      STX_ETX_STATS_ADD(p_instance, idle_discarded, skip_len);
+
+      if (in_index == in_len)
+      {
+        break;
+      }
+      p_instance->state = STX_ETX_STATE_IDLE;
+    }
+
+    if (STX_ETX_STATE_STARTED == p_instance->state)
+    {
+      size_t run_len = STX_ETX_DecodeRun(p_instance,
+                                         &p_in[in_index],
+                                         in_len - in_index,
+                                         &p_out[out_index],
+                                         out_len - out_index);
+      in_index  += run_len;
+      out_index += run_len;
+
+      if (in_index == in_len)
+      {
+        break;
+      }
+    }
+
     uint8_t value = p_in[in_index];
+#ifdef STX_ETX_STATS
+    STX_ETX_State_t state = p_instance->state;
+#endif
 
     switch (p_instance->state)
     {
@@ -287,10 +1464,21 @@ STX_ETX_Status_t STX_ETX_Decode(STX_ETX_t *     p_instance,
         break;
 
       default:
-        status = STX_ETX_DecodeInternal(p_instance, p_out, *p_out_len, &out_index, value);
+        status = STX_ETX_DecodeInternal(p_instance, p_out, out_len, &out_index, value);
         break;
     }
 
+#ifdef STX_ETX_STATS
+    if ((STX_ETX_STATE_DLE_LATCHED == state) && (STX_ETX_STATUS_CONTINUE == status))
+    {
+      STX_ETX_STATS_ADD(p_instance, escapes_decoded, 1);
+    }
+    else if ((STX_ETX_STATE_IDLE == state) && (STX_ETX_STATUS_INV_CHAR == status))
+    {
+      STX_ETX_STATS_ADD(p_instance, idle_discarded, 1);
+    }
+#endif
+
     if (STX_ETX_STATUS_OVERFLOW != status)
     {
       in_index++;
@@ -300,42 +1488,67 @@ STX_ETX_Status_t STX_ETX_Decode(STX_ETX_t *     p_instance,
   if ((STX_ETX_STATUS_OVERFLOW != status) && (STX_ETX_STATUS_CONTINUE != status))
   {
     STX_ETX_Reset(p_instance);
+
+    if (STX_ETX_STATUS_TOO_LONG == status)
+    {
+      p_instance->state = STX_ETX_STATE_DISCARD;
+    }
   }
 
-  *p_in_len  = in_index;
-  *p_out_len = out_index;
+  STX_ETX_STATS_ADD(p_instance, payload_decoded, out_index - *p_out_index);
+#ifdef STX_ETX_STATS
+  STX_ETX_StatsStatus(p_instance, status, false);
+#endif
+
+  *p_in_index  = in_index;
+  *p_out_index = out_index;
   return status;
 }
 
-
-STX_ETX_Status_t STX_ETX_Encode(STX_ETX_t *     p_instance,
-                                uint8_t const * p_in,
-                                size_t *        p_in_len,
-                                uint8_t *       p_out,
-                                size_t *        p_out_len)
+static STX_ETX_Status_t STX_ETX_EncodeData(STX_ETX_t *     p_instance,
+                                           uint8_t const * p_in,
+                                           size_t          in_len,
+                                           size_t *        p_in_index,
+                                           uint8_t *       p_out,
+                                           size_t          out_len,
+                                           size_t *        p_out_index)
 {
   STX_ETX_Status_t status    = STX_ETX_STATUS_CONTINUE;
-  size_t           in_index  = 0;
-  size_t           out_index = 0;
+  size_t           in_index  = *p_in_index;
+  size_t           out_index = *p_out_index;
 
   if (p_instance->state == STX_ETX_STATE_IDLE)
   {
-    status = STX_ETX_EncodeStart(p_instance, p_out, *p_out_len, &out_index);
+    status = STX_ETX_EncodeStart(p_instance, p_out, out_len, &out_index);
   }
 
-  while ((in_index < *p_in_len) && (STX_ETX_STATUS_CONTINUE == status))
+  while ((in_index < in_len) && (STX_ETX_STATUS_CONTINUE == status))
   {
+    if (STX_ETX_STATE_STARTED == p_instance->state)
+    {
+      size_t run_len = STX_ETX_EncodeRun(p_instance,
+                                         &p_in[in_index],
+                                         in_len - in_index,
+                                         &p_out[out_index],
+                                         out_len - out_index);
+      in_index  += run_len;
+      out_index += run_len;
+
+      if (in_index == in_len)
+      {
+        break;
+      }
+    }
+
     uint8_t value = p_in[in_index];
 
-    if ((STX == value)
-     || (ETX == value)
-     || (DLE == value))
+    if (STX_ETX_IsSpecial(value))
     {
-      status = STX_ETX_EncodeSpecial(p_instance, p_out, *p_out_len, &out_index, value);
+      status = STX_ETX_EncodeSpecial(p_instance, p_out, out_len, &out_index, value);
     }
     else
     {
-      status = STX_ETX_EncodeNotSpecial(p_instance, p_out, *p_out_len, &out_index, value);
+      status = STX_ETX_EncodeNotSpecial(p_instance, p_out, out_len, &out_index, value);
     }
 
     if (STX_ETX_STATUS_OVERFLOW != status)
@@ -344,19 +1557,42 @@ STX_ETX_Status_t STX_ETX_Encode(STX_ETX_t *     p_instance,
     }
   }
 
-  if ((p_instance->state == STX_ETX_STATE_STARTED) && (*p_in_len == in_index))
+  /* Payload mode covers consumed input at once instead of byte by byte. */
+  if (STX_ETX_IsCRCPayload(p_instance) && (in_index != *p_in_index))
+  {
+    STX_ETX_UpdateCRCBlock(p_instance, &p_in[*p_in_index], in_index - *p_in_index);
+  }
+
+  STX_ETX_STATS_ADD(p_instance, payload_encoded, in_index - *p_in_index);
+#ifdef STX_ETX_STATS
+  STX_ETX_StatsStatus(p_instance, status, true);
+#endif
+
+  *p_in_index  = in_index;
+  *p_out_index = out_index;
+  return status;
+}
+
+static STX_ETX_Status_t STX_ETX_EncodeFinal(STX_ETX_t * p_instance,
+                                            uint8_t *   p_out,
+                                            size_t      out_len,
+                                            size_t *    p_out_index)
+{
+  STX_ETX_Status_t status = STX_ETX_STATUS_CONTINUE;
+
+  if (p_instance->state == STX_ETX_STATE_STARTED)
   {
-    status = STX_ETX_EncodeEnd(p_instance, p_out, *p_out_len, &out_index);
+    status = STX_ETX_EncodeEnd(p_instance, p_out, out_len, p_out_index);
   }
 
   if (p_instance->state == STX_ETX_STATE_CRC_BYTE_0)
   {
-    status = STX_ETX_EncodeCrcByte0(p_instance, p_out, *p_out_len, &out_index);
+    status = STX_ETX_EncodeCrcByte0(p_instance, p_out, out_len, p_out_index);
   }
 
   if (p_instance->state == STX_ETX_STATE_CRC_BYTE_1)
   {
-    status = STX_ETX_EncodeCrcByte1(p_instance, p_out, *p_out_len, &out_index);
+    status = STX_ETX_EncodeCrcByte1(p_instance, p_out, out_len, p_out_index);
   }
 
   if ((STX_ETX_STATUS_OVERFLOW != status) && (STX_ETX_STATUS_CONTINUE != status))
@@ -364,25 +1600,12 @@ STX_ETX_Status_t STX_ETX_Encode(STX_ETX_t *     p_instance,
     STX_ETX_Reset(p_instance);
   }
 
-  *p_in_len  = in_index;
-  *p_out_len = out_index;
+#ifdef STX_ETX_STATS
+  STX_ETX_StatsStatus(p_instance, status, true);
+#endif
   return status;
 }
 
-/********************************************
- * LOCAL FUNCTION DEFINITIONS               *
- *******************************************/
-
-static bool STX_ETX_Write(uint8_t * p_out, size_t out_len, size_t * p_index, uint8_t value)
-{
-  if (*p_index < out_len)
-  {
-    p_out[(*p_index)++] = value;
-    return true;
-  }
-  return false;
-}
-
 static STX_ETX_Status_t STX_ETX_DecodeCrcByte0(STX_ETX_t * p_instance, uint8_t value)
 {
   p_instance->crc16 = value;
@@ -411,6 +1634,7 @@ static STX_ETX_Status_t STX_ETX_DecodeInternal(STX_ETX_t * p_instance,
                                                uint8_t     value)
 {
   STX_ETX_Status_t status;
+  size_t           index = *p_index;
 
   switch (value)
   {
@@ -431,10 +1655,15 @@ static STX_ETX_Status_t STX_ETX_DecodeInternal(STX_ETX_t * p_instance,
       break;
   }
 
-  if (STX_ETX_STATUS_OVERFLOW != status)
+  /* Written byte is payload, others are STX, ETX or escape. */
+  if (*p_index != index)
   {
     STX_ETX_UpdateCRC(p_instance, value);
   }
+  else if (STX_ETX_STATUS_OVERFLOW != status)
+  {
+    STX_ETX_UpdateWireCRC(p_instance, value);
+  }
   return status;
 }
 
@@ -451,13 +1680,13 @@ static STX_ETX_Status_t STX_ETX_DecodeOnSTX(STX_ETX_t * p_instance,
 
   if (p_instance->state == STX_ETX_STATE_DLE_LATCHED)
   {
-    if (!STX_ETX_Write(p_out, out_len, p_index, STX))
+    STX_ETX_Status_t status = STX_ETX_DecodeWrite(p_instance, p_out, out_len, p_index, STX);
+
+    if (STX_ETX_STATUS_CONTINUE == status)
     {
-      return STX_ETX_STATUS_OVERFLOW;
+      p_instance->state = STX_ETX_STATE_STARTED;
     }
-
-    p_instance->state = STX_ETX_STATE_STARTED;
-    return STX_ETX_STATUS_CONTINUE;
+    return status;
   }
 
   return STX_ETX_STATUS_INV_CHAR;
@@ -475,13 +1704,13 @@ static STX_ETX_Status_t STX_ETX_DecodeOnETX(STX_ETX_t * p_instance,
 
   if (p_instance->state == STX_ETX_STATE_DLE_LATCHED)
   {
-    if (!STX_ETX_Write(p_out, out_len, p_index, ETX))
+    STX_ETX_Status_t status = STX_ETX_DecodeWrite(p_instance, p_out, out_len, p_index, ETX);
+
+    if (STX_ETX_STATUS_CONTINUE == status)
     {
-      return STX_ETX_STATUS_OVERFLOW;
+      p_instance->state = STX_ETX_STATE_STARTED;
     }
-
-    p_instance->state = STX_ETX_STATE_STARTED;
-    return STX_ETX_STATUS_CONTINUE;
+    return status;
   }
 
   if (STX_ETX_IsCRCEnable(p_instance))
@@ -506,13 +1735,13 @@ static STX_ETX_Status_t STX_ETX_DecodeOnDLE(STX_ETX_t * p_instance,
 
   if (p_instance->state == STX_ETX_STATE_DLE_LATCHED)
   {
-    if (!STX_ETX_Write(p_out, out_len, p_index, DLE))
+    STX_ETX_Status_t status = STX_ETX_DecodeWrite(p_instance, p_out, out_len, p_index, DLE);
+
+    if (STX_ETX_STATUS_CONTINUE == status)
     {
-      return STX_ETX_STATUS_OVERFLOW;
+      p_instance->state = STX_ETX_STATE_STARTED;
     }
-
-    p_instance->state = STX_ETX_STATE_STARTED;
-    return STX_ETX_STATUS_CONTINUE;
+    return status;
   }
 
   p_instance->state = STX_ETX_STATE_DLE_LATCHED;
@@ -536,12 +1765,7 @@ static STX_ETX_Status_t STX_ETX_DecodeOnNotSpecial(STX_ETX_t * p_instance,
     return STX_ETX_STATUS_INV_CHAR;
   }
 
-  if (!STX_ETX_Write(p_out, out_len, p_index, value))
-  {
-    return STX_ETX_STATUS_OVERFLOW;
-  }
-
-  return STX_ETX_STATUS_CONTINUE;
+  return STX_ETX_DecodeWrite(p_instance, p_out, out_len, p_index, value);
 }
 
 static STX_ETX_Status_t STX_ETX_EncodeCrcByte0(STX_ETX_t * p_instance,
@@ -589,8 +1813,9 @@ static STX_ETX_Status_t STX_ETX_EncodeSpecial(STX_ETX_t * p_instance,
       return STX_ETX_STATUS_OVERFLOW;
     }
 
-    STX_ETX_UpdateCRC(p_instance, DLE);
+    STX_ETX_UpdateWireCRC(p_instance, DLE);
     p_instance->state = STX_ETX_STATE_DLE_LATCHED;
+    STX_ETX_STATS_ADD(p_instance, escapes_encoded, 1);
   }
 
   if (!STX_ETX_Write(p_out, out_len, p_index, value))
@@ -598,7 +1823,7 @@ static STX_ETX_Status_t STX_ETX_EncodeSpecial(STX_ETX_t * p_instance,
     return STX_ETX_STATUS_OVERFLOW;
   }
 
-  STX_ETX_UpdateCRC(p_instance, value);
+  STX_ETX_UpdateWireCRC(p_instance, value);
   p_instance->state = STX_ETX_STATE_STARTED;
   return STX_ETX_STATUS_CONTINUE;
 }
@@ -614,7 +1839,7 @@ static STX_ETX_Status_t STX_ETX_EncodeNotSpecial(STX_ETX_t * p_instance,
     return STX_ETX_STATUS_OVERFLOW;
   }
 
-  STX_ETX_UpdateCRC(p_instance, value);
+  STX_ETX_UpdateWireCRC(p_instance, value);
   return STX_ETX_STATUS_CONTINUE;
 }
 
@@ -628,7 +1853,7 @@ static STX_ETX_Status_t STX_ETX_EncodeStart(STX_ETX_t * p_instance,
     return STX_ETX_STATUS_OVERFLOW;
   }
 
-  STX_ETX_UpdateCRC(p_instance, STX);
+  STX_ETX_UpdateWireCRC(p_instance, STX);
   p_instance->state = STX_ETX_STATE_STARTED;
   return STX_ETX_STATUS_CONTINUE;
 }
@@ -643,7 +1868,7 @@ static STX_ETX_Status_t STX_ETX_EncodeEnd(STX_ETX_t * p_instance,
     return STX_ETX_STATUS_OVERFLOW;
   }
 
-  STX_ETX_UpdateCRC(p_instance, ETX);
+  STX_ETX_UpdateWireCRC(p_instance, ETX);
 
   if (STX_ETX_IsCRCEnable(p_instance))
   {
@@ -657,9 +1882,19 @@ static STX_ETX_Status_t STX_ETX_EncodeEnd(STX_ETX_t * p_instance,
 
 static bool STX_ETX_IsCRCEnable(STX_ETX_t * p_instance)
 {
-  STX_ETX_Config_t const * p_config = p_instance->p_config;
+  return STX_ETX_IsConfigCRCEnable(p_instance->p_config);
+}
+
+static bool STX_ETX_IsConfigCRCEnable(STX_ETX_Config_t const * p_config)
+{
+  return (NULL != p_config->update_crc16)
+      || (NULL != p_config->update_crc16_block)
+      || (NULL != p_config->p_crc16_engine);
+}
 
-  return (NULL != p_config->update_crc16);
+static bool STX_ETX_IsCRCPayload(STX_ETX_t * p_instance)
+{
+  return STX_ETX_CRC_PAYLOAD == p_instance->p_config->crc_mode;
 }
 
 static void STX_ETX_InitCRC(STX_ETX_t * p_instance)
@@ -676,8 +1911,96 @@ static void STX_ETX_UpdateCRC(STX_ETX_t * p_instance, uint8_t value)
 {
   STX_ETX_Config_t const * p_config = p_instance->p_config;
 
-  if (STX_ETX_IsCRCEnable(p_instance))
+  if (NULL != p_config->p_crc16_engine)
+  {
+    p_instance->computed_crc16 = STX_ETX_CRC16_EngineUpdateByte(p_config->p_crc16_engine,
+                                                                p_instance->computed_crc16,
+                                                                value);
+  }
+  else if (NULL != p_config->update_crc16)
   {
     p_instance->computed_crc16 = p_config->update_crc16(p_instance->computed_crc16, value);
   }
+  else if (NULL != p_config->update_crc16_block)
+  {
+    p_instance->computed_crc16 = p_config->update_crc16_block(p_instance->computed_crc16, &value, 1);
+  }
+}
+
+static void STX_ETX_UpdateCRCBlock(STX_ETX_t * p_instance, uint8_t const * p_data, size_t len)
+{
+  STX_ETX_Config_t const * p_config = p_instance->p_config;
+
+  if (NULL != p_config->p_crc16_engine)
+  {
+    p_instance->computed_crc16 = STX_ETX_CRC16_EngineUpdate(p_config->p_crc16_engine,
+                                                            p_instance->computed_crc16,
+                                                            p_data,
+                                                            len);
+  }
+  else if (NULL != p_config->update_crc16_block)
+  {
+    p_instance->computed_crc16 = p_config->update_crc16_block(p_instance->computed_crc16, p_data, len);
+  }
+  else if (NULL != p_config->update_crc16)
+  {
+    for (size_t index = 0; index < len; index++)
+    {
+      p_instance->computed_crc16 = p_config->update_crc16(p_instance->computed_crc16, p_data[index]);
+    }
+  }
+}
+
+static void STX_ETX_UpdateWireCRC(STX_ETX_t * p_instance, uint8_t value)
+{
+  if (!STX_ETX_IsCRCPayload(p_instance))
+  {
+    STX_ETX_UpdateCRC(p_instance, value);
+  }
+}
+
+static void STX_ETX_UpdateWireCRCBlock(STX_ETX_t * p_instance, uint8_t const * p_data, size_t len)
+{
+  if (!STX_ETX_IsCRCPayload(p_instance))
+  {
+    STX_ETX_UpdateCRCBlock(p_instance, p_data, len);
+  }
+}
+
+#ifdef STX_ETX_STATS
+static void STX_ETX_StatsStatus(STX_ETX_t * p_instance, STX_ETX_Status_t status, bool is_encode)
+{
+  switch (status)
+  {
+    case STX_ETX_STATUS_DONE:
+      if (is_encode)
+      {
+        STX_ETX_STATS_ADD(p_instance, frames_encoded, 1);
+      }
+      else
+      {
+        STX_ETX_STATS_ADD(p_instance, frames_decoded, 1);
+      }
+      break;
+
+    case STX_ETX_STATUS_OVERFLOW:
+      STX_ETX_STATS_ADD(p_instance, overflow_cnt, 1);
+      break;
+
+    case STX_ETX_STATUS_INV_CRC:
+      STX_ETX_STATS_ADD(p_instance, inv_crc_cnt, 1);
+      break;
+
+    case STX_ETX_STATUS_INV_CHAR:
+      STX_ETX_STATS_ADD(p_instance, inv_char_cnt, 1);
+      break;
+
+    case STX_ETX_STATUS_TOO_LONG:
+      STX_ETX_STATS_ADD(p_instance, too_long_cnt, 1);
+      break;
+
+    default:
+      break;
+  }
 }
+#endif
@@ -31,6 +31,7 @@ typedef enum
   STX_ETX_STATUS_ERR_BASE = 0xF0,
   STX_ETX_STATUS_INV_CHAR,          /**< Invalid uint8_tacter. */
   STX_ETX_STATUS_INV_CRC,           /**< Invalid CRC. */
+  STX_ETX_STATUS_TOO_LONG,          /**< Frame exceeds maximal length. */
   STX_ETX_STATUS_ERR_LAST,
 } STX_ETX_Status_t;
 
@@ -43,9 +44,22 @@ typedef enum
   STX_ETX_STATE_DLE_LATCHED,  /**< Conversion is started. Special character is expected. */
   STX_ETX_STATE_CRC_BYTE_0,   /**< Conversion is started. CRC byte 0. */
   STX_ETX_STATE_CRC_BYTE_1,   /**< Conversion is started. CRC byte 1. */
+  STX_ETX_STATE_DISCARD,      /**< Too long frame is discarded. Waiting for STX. */
 } STX_ETX_State_t;
 
 
+/** @brief STX ETX CRC coverage. */
+typedef enum
+{
+  STX_ETX_CRC_WIRE,           /**< CRC covers wire bytes from STX to ETX including escapes. */
+  STX_ETX_CRC_PAYLOAD,        /**< CRC covers decoded payload only. */
+} STX_ETX_CrcMode_t;
+
+
+/** @brief CRC16 engine (see STX_ETX_CRC.h). */
+struct STX_ETX_CRC16_Engine_s;
+
+
 /** @brief STX ETX Config. */
 typedef struct
 {
@@ -61,18 +75,102 @@ typedef struct
    *  @return uint16_t Updated CRC.
    **/
   uint16_t (*update_crc16)(uint16_t crc16, uint8_t value);
+
+  /** @brief  Update crc16 with block of bytes.
+   *
+   *  @note NULL if not provided. Then update_crc16 is called for each byte.
+   *
+   *  @param  crc16     Previous value of crc.
+   *  @param  p_data    Pointer to new bytes.
+   *  @param  len       Number of new bytes.
+   *
+   *  @return uint16_t Updated CRC.
+   **/
+  uint16_t (*update_crc16_block)(uint16_t crc16, uint8_t const * p_data, size_t len);
+
+  /** @brief  CRC16 engine.
+   *
+   *  @note NULL if not used. Takes precedence over update callbacks.
+   **/
+  struct STX_ETX_CRC16_Engine_s const * p_crc16_engine;
+
+  size_t max_frame_len; //!< Maximal number of decoded bytes of frame, 0 if not limited.
+
+  STX_ETX_CrcMode_t crc_mode; //!< CRC coverage, wire bytes (compatible with older devices) if not set.
 } STX_ETX_Config_t;
 
 
+#ifdef STX_ETX_STATS
+/** @brief STX ETX Statistics counters. */
+typedef struct
+{
+  uint64_t                       frames_decoded;  //!< Number of decoded frames.
+  uint64_t                       frames_encoded;  //!< Number of encoded frames.
+  uint64_t                       payload_decoded; //!< Number of bytes written by decoder.
+  uint64_t                       payload_encoded; //!< Number of payload bytes read by encoder.
+  uint64_t                       escapes_decoded; //!< Number of escape sequences decoded.
+  uint64_t                       escapes_encoded; //!< Number of escape sequences encoded.
+  uint64_t                       inv_crc_cnt;     //!< Number of CRC failures.
+  uint64_t                       inv_char_cnt;    //!< Number of invalid character events.
+  uint64_t                       overflow_cnt;    //!< Number of OVERFLOW returns.
+  uint64_t                       idle_discarded;  //!< Number of bytes discarded while idle.
+  uint64_t                       too_long_cnt;    //!< Number of frames exceeding maximal length.
+} STX_ETX_StatsCounters_t;
+
+
+/** @brief STX ETX Statistics.
+ *
+ *  @note Counters are written by the thread using the parser instance.
+ *        Snapshot and reset may be called from one other thread.
+ */
+typedef struct
+{
+  STX_ETX_StatsCounters_t        counters;        //!< Counters since attach.
+  STX_ETX_StatsCounters_t        base;            //!< Counters at last reset.
+} STX_ETX_Stats_t;
+#endif
+
+
 /** @brief STX ETX Instance. */
 typedef struct
 {
   STX_ETX_State_t                state;           //!< State.
   uint16_t                       computed_crc16;  //!< Computed CRC.
   uint16_t                       crc16;           //!< Decoded CRC.
+  size_t                         frame_len;       //!< Number of decoded bytes of current frame.
   STX_ETX_Config_t const *       p_config;        //!< Pointer to configuration.
+#ifdef STX_ETX_STATS
+  STX_ETX_Stats_t *              p_stats;         //!< Pointer to statistics, NULL if not attached.
+#endif
 } STX_ETX_t;
 
+
+/** @brief STX ETX Resynchronization counters. */
+typedef struct
+{
+  size_t                         skipped_len;     //!< Number of bytes skipped outside of frames.
+  size_t                         inv_char_cnt;    //!< Number of frames dropped due to invalid character.
+  size_t                         inv_crc_cnt;     //!< Number of frames dropped due to invalid CRC.
+  size_t                         too_long_cnt;    //!< Number of frames dropped due to maximal length.
+} STX_ETX_Resync_t;
+
+
+/** @brief STX ETX Data span. */
+typedef struct
+{
+  uint8_t const *                p_data;          //!< Pointer to data.
+  size_t                         len;             //!< Data length.
+} STX_ETX_Span_t;
+
+
+/** @brief STX ETX Frame descriptor. */
+typedef struct
+{
+  size_t                         offset;          //!< Offset of decoded data in output buffer.
+  size_t                         len;             //!< Length of decoded data.
+  STX_ETX_Status_t               status;          //!< Frame status.
+} STX_ETX_Frame_t;
+
 /********************************************
  * EXPORTED #define CONSTANTS AND MACROS    *
  ********************************************/
@@ -114,7 +212,55 @@ void STX_ETX_Reset(STX_ETX_t * p_instance);
 bool STX_ETX_IsError(STX_ETX_Status_t status);
 
 
+/** @brief Find first special byte (STX, ETX or DLE).
+ *
+ *  @note Uses AVX2/SSE2 when enabled by compiler, 64-bit word scan otherwise.
+ *
+ *  @param [in]      p_in     Pointer to input buffer.
+ *  @param [in]      in_len   Input buffer length.
+ *
+ *  @return size_t Index of first special byte, in_len if there is none.
+ */
+size_t STX_ETX_FindSpecial(uint8_t const * p_in, size_t in_len);
+
+
+#ifdef STX_ETX_STATS
+/** @brief Attach statistics to STX-ETX Parser.
+ *
+ *  @note Statistics are cleared. Call after STX_ETX_Init.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      p_stats    Pointer to statistics, NULL to detach.
+ *
+ *  @return void.
+ */
+void STX_ETX_StatsAttach(STX_ETX_t * p_instance, STX_ETX_Stats_t * p_stats);
+
+
+/** @brief Get statistics counters since last reset.
+ *
+ *  @param [in]      p_stats    Pointer to statistics.
+ *  @param [out]     p_counters Pointer to counters snapshot.
+ *
+ *  @return void.
+ */
+void STX_ETX_StatsSnapshot(STX_ETX_Stats_t const * p_stats, STX_ETX_StatsCounters_t * p_counters);
+
+
+/** @brief Reset statistics counters.
+ *
+ *  @param [in,out]  p_stats    Pointer to statistics.
+ *
+ *  @return void.
+ */
+void STX_ETX_StatsReset(STX_ETX_Stats_t * p_stats);
+#endif
+
+
 /** @brief Decode STX-ETX data.
+ *
+ *  @note If max_frame_len of configuration is set, TOO_LONG is returned as
+ *        soon as frame exceeds it. Following bytes are discarded until next STX.
  *
  *  @param [in]      p_instance Pointer to parser instance.
  *  @param [in]      p_in       Pointer to input buffer.
@@ -133,6 +279,166 @@ STX_ETX_Status_t STX_ETX_Decode(STX_ETX_t *     p_instance,
                                 size_t *        p_out_len);
 
 
+/** @brief Decode STX-ETX data skipping garbage and invalid frames.
+ *
+ *  @note Works as STX_ETX_Decode, but bytes outside of frames are skipped and
+ *        invalid frames are dropped and counted instead of ending the call.
+ *        Unexpected STX inside frame starts new frame.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      p_in       Pointer to input buffer.
+ *  @param [in,out]  p_in_len   in:  Input buffer length.
+ *                              out: Number of bytes read from input buffer.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in,out]  p_out_len  in:  Output buffer length.
+ *                              out: Number of bytes written to output buffer.
+ *  @param [in,out]  p_resync   Pointer to resynchronization counters (accumulated).
+ *
+ *  @return STX_ETX_Status_t DONE, CONTINUE or OVERFLOW.
+ */
+STX_ETX_Status_t STX_ETX_DecodeResync(STX_ETX_t *        p_instance,
+                                     uint8_t const *    p_in,
+                                     size_t *           p_in_len,
+                                     uint8_t *          p_out,
+                                     size_t *           p_out_len,
+                                     STX_ETX_Resync_t * p_resync);
+
+
+/** @brief Decode multiple STX-ETX frames.
+ *
+ *  @note Frames are decoded back-to-back into output buffer. Each frame gets
+ *        descriptor with its status: DONE or error for finished frames
+ *        (data of invalid frames is dropped), CONTINUE or OVERFLOW for the
+ *        last, unfinished frame, which is continued by the next call.
+ *
+ *  @param [in]      p_instance   Pointer to parser instance.
+ *  @param [in]      p_in         Pointer to input buffer.
+ *  @param [in,out]  p_in_len     in:  Input buffer length.
+ *                                out: Number of bytes read from input buffer.
+ *  @param [out]     p_out        Pointer to output buffer.
+ *  @param [in,out]  p_out_len    in:  Output buffer length.
+ *                                out: Number of bytes written to output buffer.
+ *  @param [out]     p_frames     Pointer to frame descriptors.
+ *  @param [in,out]  p_frames_cnt in:  Number of frame descriptors.
+ *                                out: Number of filled frame descriptors.
+ *
+ *  @return STX_ETX_Status_t Status of the last frame,
+ *                           OVERFLOW if output or descriptors are exhausted before input.
+ */
+STX_ETX_Status_t STX_ETX_DecodeBatch(STX_ETX_t *       p_instance,
+                                    uint8_t const *   p_in,
+                                    size_t *          p_in_len,
+                                    uint8_t *         p_out,
+                                    size_t *          p_out_len,
+                                    STX_ETX_Frame_t * p_frames,
+                                    size_t *          p_frames_cnt);
+
+
+/** @brief Decode multiple STX-ETX frames in place.
+ *
+ *  @note Works as STX_ETX_DecodeBatch with output buffer being input buffer.
+ *        Decoded data never exceeds encoded data, so read bytes are overwritten
+ *        with decoded frames and output never overflows.
+ *
+ *  @param [in]      p_instance   Pointer to parser instance.
+ *  @param [in,out]  p_buf        Pointer to buffer.
+ *  @param [in,out]  p_buf_len    in:  Buffer length.
+ *                                out: Number of bytes read from buffer.
+ *  @param [out]     p_frames     Pointer to frame descriptors (offsets in buffer).
+ *  @param [in,out]  p_frames_cnt in:  Number of frame descriptors.
+ *                                out: Number of filled frame descriptors.
+ *
+ *  @return STX_ETX_Status_t Status of the last frame,
+ *                           OVERFLOW if descriptors are exhausted before input.
+ */
+STX_ETX_Status_t STX_ETX_DecodeInPlace(STX_ETX_t *       p_instance,
+                                      uint8_t *         p_buf,
+                                      size_t *          p_buf_len,
+                                      STX_ETX_Frame_t * p_frames,
+                                      size_t *          p_frames_cnt);
+
+
+/** @brief Decode STX-ETX data with table driven state machine.
+ *
+ *  @note Works as STX_ETX_Decode. Each byte is classified and handled by
+ *        [state][class] transition table, so data and escaped bytes are
+ *        processed without branches and CRC is updated once per call.
+ *        Input and output buffers must not overlap. Unlike STX_ETX_Decode,
+ *        bytes of output buffer after returned output length (within its
+ *        input length) may be overwritten, as every input byte is stored
+ *        before it is known, if it is emitted.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      p_in       Pointer to input buffer.
+ *  @param [in,out]  p_in_len   in:  Input buffer length.
+ *                              out: Number of bytes read from input buffer.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in,out]  p_out_len  in:  Output buffer length.
+ *                              out: Number of bytes written to output buffer.
+ *
+ *  @return STX_ETX_Status_t.
+ */
+STX_ETX_Status_t STX_ETX_DecodeTable(STX_ETX_t *     p_instance,
+                                     uint8_t const * p_in,
+                                     size_t *        p_in_len,
+                                     uint8_t *       p_out,
+                                     size_t *        p_out_len);
+
+
+/** @brief Decode STX-ETX data without copying escape-free frames.
+ *
+ *  @note Works as STX_ETX_Decode. When frame starts at the beginning of input,
+ *        ends in input and contains no escaped characters, decoded data is
+ *        returned as view into input buffer and nothing is written to output.
+ *        Otherwise decoded data is copied into output buffer.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      p_in       Pointer to input buffer.
+ *  @param [in,out]  p_in_len   in:  Input buffer length.
+ *                              out: Number of bytes read from input buffer.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in,out]  p_out_len  in:  Output buffer length.
+ *                              out: Number of bytes written to output buffer.
+ *  @param [out]     pp_data    Pointer to decoded data (in input or output buffer).
+ *  @param [out]     p_data_len Length of decoded data.
+ *
+ *  @return STX_ETX_Status_t.
+ */
+STX_ETX_Status_t STX_ETX_DecodeView(STX_ETX_t *      p_instance,
+                                   uint8_t const *  p_in,
+                                   size_t *         p_in_len,
+                                   uint8_t *        p_out,
+                                   size_t *         p_out_len,
+                                   uint8_t const ** pp_data,
+                                   size_t *         p_data_len);
+
+
+/** @brief Compute size of encoded STX-ETX frame.
+ *
+ *  @param [in]      p_config   Pointer to parser configuration.
+ *  @param [in]      p_in       Pointer to input buffer.
+ *  @param [in]      in_len     Input buffer length.
+ *
+ *  @return size_t Exact number of bytes written by STX_ETX_Encode for given input.
+ */
+size_t STX_ETX_EncodedSize(STX_ETX_Config_t const * p_config,
+                           uint8_t const *          p_in,
+                           size_t                   in_len);
+
+
+/** @brief Compute size of encoded STX-ETX frame from multiple spans.
+ *
+ *  @param [in]      p_config   Pointer to parser configuration.
+ *  @param [in]      p_spans    Pointer to input spans.
+ *  @param [in]      spans_cnt  Number of input spans.
+ *
+ *  @return size_t Exact number of bytes written by STX_ETX_EncodeV for given spans.
+ */
+size_t STX_ETX_EncodedSizeV(STX_ETX_Config_t const * p_config,
+                            STX_ETX_Span_t const *   p_spans,
+                            size_t                   spans_cnt);
+
+
 /** @brief Encode STX-ETX data.
  *
  *  @param [in]      p_instance Pointer to parser instance.
@@ -151,4 +457,108 @@ STX_ETX_Status_t STX_ETX_Encode(STX_ETX_t *     p_instance,
                                 uint8_t *       p_out,
                                 size_t *        p_out_len);
 
+
+
+/** @brief Start encoding of STX-ETX frame.
+ *
+ *  @note Optional, STX_ETX_EncodeAppend starts frame too.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in,out]  p_out_len  in:  Output buffer length.
+ *                              out: Number of bytes written to output buffer.
+ *
+ *  @return STX_ETX_Status_t CONTINUE or OVERFLOW.
+ */
+STX_ETX_Status_t STX_ETX_EncodeBegin(STX_ETX_t * p_instance,
+                                     uint8_t *   p_out,
+                                     size_t *    p_out_len);
+
+
+/** @brief Append data to encoded STX-ETX frame.
+ *
+ *  @note Frame is not finished, when input is consumed.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      p_in       Pointer to input buffer.
+ *  @param [in,out]  p_in_len   in:  Input buffer length.
+ *                              out: Number of bytes read from input buffer.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in,out]  p_out_len  in:  Output buffer length.
+ *                              out: Number of bytes written to output buffer.
+ *
+ *  @return STX_ETX_Status_t CONTINUE, if input is consumed, OVERFLOW otherwise.
+ */
+STX_ETX_Status_t STX_ETX_EncodeAppend(STX_ETX_t *     p_instance,
+                                      uint8_t const * p_in,
+                                      size_t *        p_in_len,
+                                      uint8_t *       p_out,
+                                      size_t *        p_out_len);
+
+
+/** @brief Finish encoded STX-ETX frame.
+ *
+ *  @note Call again with new output buffer on OVERFLOW.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in,out]  p_out_len  in:  Output buffer length.
+ *                              out: Number of bytes written to output buffer.
+ *
+ *  @return STX_ETX_Status_t DONE or OVERFLOW.
+ */
+STX_ETX_Status_t STX_ETX_EncodeFinish(STX_ETX_t * p_instance,
+                                      uint8_t *   p_out,
+                                      size_t *    p_out_len);
+
+
+/** @brief Encode STX-ETX frame from multiple spans.
+ *
+ *  @note Spans are encoded as one frame. On OVERFLOW call again with the same
+ *        spans, updated offset and new output buffer.
+ *
+ *  @param [in]      p_instance  Pointer to parser instance.
+ *  @param [in]      p_spans     Pointer to input spans.
+ *  @param [in]      spans_cnt   Number of input spans.
+ *  @param [in,out]  p_in_offset in:  Number of bytes of spans read by previous calls.
+ *                               out: Number of bytes of spans read.
+ *  @param [out]     p_out       Pointer to output buffer.
+ *  @param [in,out]  p_out_len   in:  Output buffer length.
+ *                               out: Number of bytes written to output buffer.
+ *
+ *  @return STX_ETX_Status_t DONE or OVERFLOW.
+ */
+STX_ETX_Status_t STX_ETX_EncodeV(STX_ETX_t *            p_instance,
+                                 STX_ETX_Span_t const * p_spans,
+                                 size_t                 spans_cnt,
+                                 size_t *               p_in_offset,
+                                 uint8_t *              p_out,
+                                 size_t *               p_out_len);
+
+
+/** @brief Encode multiple messages into STX-ETX frames.
+ *
+ *  @note Each message is encoded as one frame, frames are written back-to-back
+ *        into output buffer. Only whole frames are written: encoding stops at
+ *        the first message, whose frame does not fit, so the call can be
+ *        repeated with remaining messages and new output buffer.
+ *
+ *  @param [in]      p_instance Pointer to parser instance (not encoding).
+ *  @param [in]      p_msgs     Pointer to messages.
+ *  @param [in,out]  p_msgs_cnt in:  Number of messages.
+ *                              out: Number of encoded messages.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in,out]  p_out_len  in:  Output buffer length.
+ *                              out: Number of bytes written to output buffer.
+ *  @param [out]     p_frames   Pointer to frame descriptors (one per message).
+ *
+ *  @return STX_ETX_Status_t DONE, if all messages are encoded, OVERFLOW otherwise.
+ */
+STX_ETX_Status_t STX_ETX_EncodeBatch(STX_ETX_t *            p_instance,
+                                     STX_ETX_Span_t const * p_msgs,
+                                     size_t *               p_msgs_cnt,
+                                     uint8_t *              p_out,
+                                     size_t *               p_out_len,
+                                     STX_ETX_Frame_t *      p_frames);
+
 #endif /* #ifndef STX_ETX_H */
@@ -0,0 +1,151 @@
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include "STX_ETX_Alloc.h"
+
+/********************************************
+ * LOCAL FUNCTIONS PROTOTYPES               *
+ ********************************************/
+
+/** @brief Grow frame in progress of bump arena.
+ *
+ *  @note Frame takes all free space of arena.
+ *
+ *  @param [in]      p_context  Pointer to arena.
+ *  @param [in]      p_data     Pointer to frame, NULL if not started yet.
+ *  @param [in]      len        Number of bytes used.
+ *  @param [in]      min_len    Requested capacity.
+ *  @param [out]     p_capacity Capacity of frame.
+ *
+ *  @return uint8_t * Pointer to frame, NULL if arena is full.
+ */
+static uint8_t * STX_ETX_Arena_Grow(void *    p_context,
+                                    uint8_t * p_data,
+                                    size_t    len,
+                                    size_t    min_len,
+                                    size_t *  p_capacity);
+
+
+/** @brief Commit finished frame of bump arena.
+ *
+ *  @param [in]      p_context  Pointer to arena.
+ *  @param [in]      p_data     Pointer to frame.
+ *  @param [in]      len        Frame length.
+ *
+ *  @return void.
+ */
+static void STX_ETX_Arena_Commit(void * p_context, uint8_t * p_data, size_t len);
+
+/********************************************
+ * EXPORTED FUNCTION DEFINITIONS            *
+ ********************************************/
+
+STX_ETX_Status_t STX_ETX_DecodeAlloc(STX_ETX_t *                 p_instance,
+                                     uint8_t const *             p_in,
+                                     size_t *                    p_in_len,
+                                     STX_ETX_Buffer_t *          p_out,
+                                     STX_ETX_Allocator_t const * p_allocator)
+{
+  STX_ETX_Status_t status   = STX_ETX_STATUS_OVERFLOW;
+  size_t           in_index = 0;
+
+  while (STX_ETX_STATUS_OVERFLOW == status)
+  {
+    if (p_out->len == p_out->capacity)
+    {
+      size_t max_frame_len = p_instance->p_config->max_frame_len;
+      size_t min_len       = (0 != p_out->capacity) ? (2 * p_out->capacity) : STX_ETX_ALLOC_MIN_LEN;
+
+      /* Frame never needs more than max_frame_len + 1 bytes (the last one is rejected). */
+      if ((0 != max_frame_len) && (min_len > max_frame_len + 1))
+      {
+        min_len = max_frame_len + 1;
+      }
+
+      uint8_t * p_data = p_allocator->grow(p_allocator->p_context, p_out->p_data, p_out->len, min_len, &p_out->capacity);
+
+      if (NULL == p_data)
+      {
+        break;
+      }
+      p_out->p_data = p_data;
+    }
+
+    size_t in_len  = *p_in_len - in_index;
+    size_t out_len = p_out->capacity - p_out->len;
+
+    status = STX_ETX_Decode(p_instance, &p_in[in_index], &in_len, &p_out->p_data[p_out->len], &out_len);
+
+    in_index   += in_len;
+    p_out->len += out_len;
+  }
+
+  if (STX_ETX_IsError(status))
+  {
+    p_out->len = 0;
+  }
+  else if ((STX_ETX_STATUS_DONE == status) && (NULL != p_allocator->commit))
+  {
+    p_allocator->commit(p_allocator->p_context, p_out->p_data, p_out->len);
+  }
+
+  *p_in_len = in_index;
+  return status;
+}
+
+void STX_ETX_Arena_Init(STX_ETX_Arena_t * p_arena, void * p_storage, size_t size)
+{
+  p_arena->p_storage = (uint8_t *)p_storage;
+  p_arena->size      = size;
+  p_arena->used      = 0;
+}
+
+void STX_ETX_Arena_Reset(STX_ETX_Arena_t * p_arena)
+{
+  p_arena->used = 0;
+}
+
+void STX_ETX_Arena_GetAllocator(STX_ETX_Arena_t * p_arena, STX_ETX_Allocator_t * p_allocator)
+{
+  p_allocator->grow      = STX_ETX_Arena_Grow;
+  p_allocator->commit    = STX_ETX_Arena_Commit;
+  p_allocator->p_context = p_arena;
+}
+
+/********************************************
+ * LOCAL FUNCTION DEFINITIONS               *
+ ********************************************/
+
+static uint8_t * STX_ETX_Arena_Grow(void *    p_context,
+                                    uint8_t * p_data,
+                                    size_t    len,
+                                    size_t    min_len,
+                                    size_t *  p_capacity)
+{
+  STX_ETX_Arena_t * p_arena = (STX_ETX_Arena_t *)p_context;
+
+  (void)min_len;
+
+  if (NULL == p_data)
+  {
+    p_data = &p_arena->p_storage[p_arena->used];
+  }
+
+  size_t capacity = p_arena->size - (size_t)(p_data - p_arena->p_storage);
+
+  if (capacity <= len)
+  {
+    return NULL;
+  }
+
+  *p_capacity = capacity;
+  return p_data;
+}
+
+static void STX_ETX_Arena_Commit(void * p_context, uint8_t * p_data, size_t len)
+{
+  STX_ETX_Arena_t * p_arena = (STX_ETX_Arena_t *)p_context;
+
+  p_arena->used = (size_t)(p_data - p_arena->p_storage) + len;
+}
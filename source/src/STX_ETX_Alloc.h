@@ -0,0 +1,146 @@
+#ifndef STX_ETX_ALLOC_H
+#define STX_ETX_ALLOC_H
+
+/**
+ *  @file STX_ETX_Alloc.h
+ *  @brief Header file for STX-ETX Parser growable output
+ *
+ *         This file contains API of decoding into output buffer, which is
+ *         grown through allocator interface while frame is in progress,
+ *         and of bump arena, which grows the buffer in place.
+ *
+ *  @author Wojciech Jasko
+ */
+
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "STX_ETX.h"
+
+/********************************************
+ * EXPORTED #define CONSTANTS AND MACROS    *
+ ********************************************/
+
+#define STX_ETX_ALLOC_MIN_LEN  64  /** Capacity requested for empty output buffer. */
+
+/********************************************
+ * EXPORTED TYPES DEFINITIONS               *
+ ********************************************/
+
+/** @brief STX ETX Growable output buffer. */
+typedef struct
+{
+  uint8_t *                      p_data;          //!< Pointer to data, NULL if not allocated.
+  size_t                         len;             //!< Number of bytes of frame decoded so far.
+  size_t                         capacity;        //!< Number of bytes allocated.
+} STX_ETX_Buffer_t;
+
+
+/** @brief STX ETX Allocator. */
+typedef struct
+{
+  /** @brief  Grow output buffer.
+   *
+   *  @note First len bytes must be preserved (moved, if buffer is moved).
+   *
+   *  @param  p_context   Allocator context.
+   *  @param  p_data      Pointer to buffer, NULL if not allocated yet.
+   *  @param  len         Number of bytes used.
+   *  @param  min_len     Requested capacity, at least len + 1.
+   *  @param  p_capacity  out: Capacity of grown buffer (at least len + 1).
+   *
+   *  @return uint8_t * Pointer to grown buffer, NULL if allocation failed.
+   **/
+  uint8_t * (*grow)(void * p_context, uint8_t * p_data, size_t len, size_t min_len, size_t * p_capacity);
+
+  /** @brief  Commit finished frame.
+   *
+   *  @note NULL if not needed. Capacity above len may be given back.
+   *
+   *  @param  p_context   Allocator context.
+   *  @param  p_data      Pointer to buffer.
+   *  @param  len         Frame length.
+   **/
+  void (*commit)(void * p_context, uint8_t * p_data, size_t len);
+
+  void *                         p_context;       //!< Allocator context.
+} STX_ETX_Allocator_t;
+
+
+/** @brief STX ETX Bump arena. */
+typedef struct
+{
+  uint8_t *                      p_storage;       //!< Pointer to storage.
+  size_t                         size;            //!< Storage size.
+  size_t                         used;            //!< Number of bytes taken by committed frames.
+} STX_ETX_Arena_t;
+
+/********************************************
+ * EXPORTED FUNCTIONS PROTOTYPES            *
+ ********************************************/
+
+/** @brief Decode STX-ETX data into growable output buffer.
+ *
+ *  @note Works as STX_ETX_Decode, but output buffer is grown, when it is full,
+ *        so call returns only on DONE, error or consumed input (CONTINUE).
+ *        Capacity is doubled (limited by max_frame_len of configuration).
+ *        OVERFLOW is returned only, if allocator fails; call again after
+ *        space is released. On error frame data is dropped (len is 0).
+ *        On DONE frame is committed and buffer holds it; reset buffer
+ *        (or its length) before next frame is decoded. Statistics count
+ *        each growth as OVERFLOW.
+ *
+ *  @param [in]      p_instance  Pointer to parser instance.
+ *  @param [in]      p_in        Pointer to input buffer.
+ *  @param [in,out]  p_in_len    in:  Input buffer length.
+ *                               out: Number of bytes read from input buffer.
+ *  @param [in,out]  p_out       Pointer to output buffer.
+ *  @param [in]      p_allocator Pointer to allocator.
+ *
+ *  @return STX_ETX_Status_t.
+ */
+STX_ETX_Status_t STX_ETX_DecodeAlloc(STX_ETX_t *                 p_instance,
+                                     uint8_t const *             p_in,
+                                     size_t *                    p_in_len,
+                                     STX_ETX_Buffer_t *          p_out,
+                                     STX_ETX_Allocator_t const * p_allocator);
+
+
+/** @brief Initialize bump arena.
+ *
+ *  @param [out]     p_arena    Pointer to arena.
+ *  @param [in]      p_storage  Pointer to storage.
+ *  @param [in]      size       Storage size.
+ *
+ *  @return void.
+ */
+void STX_ETX_Arena_Init(STX_ETX_Arena_t * p_arena, void * p_storage, size_t size);
+
+
+/** @brief Release all frames of arena.
+ *
+ *  @param [in,out]  p_arena    Pointer to arena.
+ *
+ *  @return void.
+ */
+void STX_ETX_Arena_Reset(STX_ETX_Arena_t * p_arena);
+
+
+/** @brief Get allocator of bump arena.
+ *
+ *  @note Frame in progress takes all free space of arena, so it is grown in
+ *        place and never copied. Committed frame keeps only its length.
+ *
+ *  @param [in]      p_arena     Pointer to arena.
+ *  @param [out]     p_allocator Pointer to allocator.
+ *
+ *  @return void.
+ */
+void STX_ETX_Arena_GetAllocator(STX_ETX_Arena_t * p_arena, STX_ETX_Allocator_t * p_allocator);
+
+#endif /* #ifndef STX_ETX_ALLOC_H */
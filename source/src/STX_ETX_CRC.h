@@ -0,0 +1,166 @@
+#ifndef STX_ETX_CRC_H
+#define STX_ETX_CRC_H
+
+/**
+ *  @file STX_ETX_CRC.h
+ *  @brief Header file for STX-ETX Parser built-in CRC16
+ *
+ *         This file contains table driven (slice-by-8) CRC16 implementations
+ *         of common presets and CRC16 engine for arbitrary polynomial with
+ *         carry-less multiplication folding, which can be used in STX-ETX
+ *         Parser configuration.
+ *
+ *  @author Wojciech Jasko
+ */
+
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "STX_ETX.h"
+
+/********************************************
+ * EXPORTED TYPES DEFINITIONS               *
+ ********************************************/
+
+/** @brief CRC16 presets. */
+typedef enum
+{
+  STX_ETX_CRC16_ARC,          /**< Polynomial 0x8005, reflected, initial value 0x0000. */
+  STX_ETX_CRC16_CCITT_FALSE,  /**< Polynomial 0x1021, not reflected, initial value 0xFFFF. */
+  STX_ETX_CRC16_MODBUS,       /**< Polynomial 0x8005, reflected, initial value 0xFFFF. */
+  STX_ETX_CRC16_XMODEM,       /**< Polynomial 0x1021, not reflected, initial value 0x0000. */
+  STX_ETX_CRC16_LAST,
+} STX_ETX_CRC16_Preset_t;
+
+
+/** @brief CRC16 engine kernels. */
+typedef enum
+{
+  STX_ETX_CRC16_KERNEL_TABLE,   /**< Portable slice-by-8 tables. */
+  STX_ETX_CRC16_KERNEL_CLMUL,   /**< x86 carry-less multiplication (PCLMULQDQ) folding. */
+  STX_ETX_CRC16_KERNEL_PMULL,   /**< ARMv8 polynomial multiplication (PMULL) folding. */
+  STX_ETX_CRC16_KERNEL_LAST,
+} STX_ETX_CRC16_Kernel_t;
+
+
+/** @brief CRC16 engine for arbitrary 16-bit polynomial. */
+typedef struct STX_ETX_CRC16_Engine_s
+{
+  uint16_t               polynomial;     //!< Polynomial in normal representation (without x^16).
+  bool                   reflected;      //!< True, if input and CRC are reflected.
+  STX_ETX_CRC16_Kernel_t kernel;         //!< Selected kernel.
+  uint64_t               fold_128[2];    //!< Constants folding 128 bits (low, high half).
+  uint64_t               fold_512[2];    //!< Constants folding 512 bits (low, high half).
+  uint16_t               table[8][256];  //!< Slice-by-8 tables.
+} STX_ETX_CRC16_Engine_t;
+
+/********************************************
+ * EXPORTED FUNCTIONS PROTOTYPES            *
+ ********************************************/
+
+/** @brief Fill parser configuration with CRC16 preset.
+ *
+ *  @param [in]      preset     CRC16 preset.
+ *  @param [out]     p_config   Pointer to parser configuration.
+ *
+ *  @return bool  True, if preset is known.
+ */
+bool STX_ETX_CRC16_GetConfig(STX_ETX_CRC16_Preset_t preset, STX_ETX_Config_t * p_config);
+
+
+/** @brief Update reflected 0x8005 CRC16 (ARC, MODBUS) with single byte.
+ *
+ *  @param [in]      crc16      Previous value of crc.
+ *  @param [in]      value      New byte.
+ *
+ *  @return uint16_t Updated CRC.
+ */
+uint16_t STX_ETX_CRC16_Update8005Reflected(uint16_t crc16, uint8_t value);
+
+
+/** @brief Update reflected 0x8005 CRC16 (ARC, MODBUS) with block of bytes.
+ *
+ *  @param [in]      crc16      Previous value of crc.
+ *  @param [in]      p_data     Pointer to data.
+ *  @param [in]      len        Data length.
+ *
+ *  @return uint16_t Updated CRC.
+ */
+uint16_t STX_ETX_CRC16_UpdateBlock8005Reflected(uint16_t crc16, uint8_t const * p_data, size_t len);
+
+
+/** @brief Update 0x1021 CRC16 (CCITT-FALSE, XMODEM) with single byte.
+ *
+ *  @param [in]      crc16      Previous value of crc.
+ *  @param [in]      value      New byte.
+ *
+ *  @return uint16_t Updated CRC.
+ */
+uint16_t STX_ETX_CRC16_Update1021(uint16_t crc16, uint8_t value);
+
+
+/** @brief Update 0x1021 CRC16 (CCITT-FALSE, XMODEM) with block of bytes.
+ *
+ *  @param [in]      crc16      Previous value of crc.
+ *  @param [in]      p_data     Pointer to data.
+ *  @param [in]      len        Data length.
+ *
+ *  @return uint16_t Updated CRC.
+ */
+uint16_t STX_ETX_CRC16_UpdateBlock1021(uint16_t crc16, uint8_t const * p_data, size_t len);
+
+
+/** @brief Initialize CRC16 engine.
+ *
+ *  @note The fastest kernel supported by CPU is selected (CPUID on x86).
+ *
+ *  @param [out]     p_engine   Pointer to engine.
+ *  @param [in]      polynomial Polynomial in normal representation (without x^16), e.g. 0x8005.
+ *  @param [in]      reflected  True, if input and CRC are reflected.
+ *
+ *  @return void.
+ */
+void STX_ETX_CRC16_EngineInit(STX_ETX_CRC16_Engine_t * p_engine, uint16_t polynomial, bool reflected);
+
+
+/** @brief Select CRC16 engine kernel.
+ *
+ *  @param [in,out]  p_engine   Pointer to engine.
+ *  @param [in]      kernel     Kernel.
+ *
+ *  @return bool  True, if kernel is supported by CPU and it was selected.
+ */
+bool STX_ETX_CRC16_EngineSetKernel(STX_ETX_CRC16_Engine_t * p_engine, STX_ETX_CRC16_Kernel_t kernel);
+
+
+/** @brief Update CRC16 with single byte using engine.
+ *
+ *  @param [in]      p_engine   Pointer to engine.
+ *  @param [in]      crc16      Previous value of crc.
+ *  @param [in]      value      New byte.
+ *
+ *  @return uint16_t Updated CRC.
+ */
+uint16_t STX_ETX_CRC16_EngineUpdateByte(STX_ETX_CRC16_Engine_t const * p_engine, uint16_t crc16, uint8_t value);
+
+
+/** @brief Update CRC16 with block of bytes using engine.
+ *
+ *  @param [in]      p_engine   Pointer to engine.
+ *  @param [in]      crc16      Previous value of crc.
+ *  @param [in]      p_data     Pointer to data.
+ *  @param [in]      len        Data length.
+ *
+ *  @return uint16_t Updated CRC.
+ */
+uint16_t STX_ETX_CRC16_EngineUpdate(STX_ETX_CRC16_Engine_t const * p_engine,
+                                    uint16_t                       crc16,
+                                    uint8_t const *                p_data,
+                                    size_t                         len);
+
+#endif /* #ifndef STX_ETX_CRC_H */
@@ -0,0 +1,190 @@
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <string.h>
+
+#include "STX_ETX_Channels.h"
+
+/********************************************
+ * LOCAL FUNCTIONS PROTOTYPES               *
+ ********************************************/
+
+/** @brief Load channel state to parser instance.
+ *
+ *  @param [in]      p_channels Pointer to channel pool.
+ *  @param [in]      channel_id Channel identifier.
+ *  @param [out]     p_instance Pointer to parser instance.
+ *
+ *  @return void.
+ */
+static void STX_ETX_Channels_Load(STX_ETX_Channels_t const * p_channels,
+                                  size_t                     channel_id,
+                                  STX_ETX_t *                p_instance);
+
+
+/** @brief Store parser instance to channel state.
+ *
+ *  @param [in,out]  p_channels Pointer to channel pool.
+ *  @param [in]      channel_id Channel identifier.
+ *  @param [in]      p_instance Pointer to parser instance.
+ *
+ *  @return void.
+ */
+static void STX_ETX_Channels_Store(STX_ETX_Channels_t * p_channels,
+                                   size_t               channel_id,
+                                   STX_ETX_t const *    p_instance);
+
+/********************************************
+ * EXPORTED FUNCTION DEFINITIONS            *
+ ********************************************/
+
+void STX_ETX_Channels_Init(STX_ETX_Channels_t *     p_channels,
+                           void *                   p_storage,
+                           size_t                   channels_cnt,
+                           STX_ETX_Config_t const * p_configs)
+{
+  p_channels->p_frame_len      = (uint32_t *)p_storage;
+  p_channels->p_computed_crc16 = (uint16_t *)&p_channels->p_frame_len[channels_cnt];
+  p_channels->p_crc16          = &p_channels->p_computed_crc16[channels_cnt];
+  p_channels->p_state          = (uint8_t *)&p_channels->p_crc16[channels_cnt];
+  p_channels->p_config_index   = &p_channels->p_state[channels_cnt];
+  p_channels->channels_cnt     = channels_cnt;
+  p_channels->p_configs        = p_configs;
+#ifdef STX_ETX_STATS
+  p_channels->p_stats          = NULL;
+#endif
+
+  for (size_t channel_id = 0; channel_id < channels_cnt; channel_id++)
+  {
+    STX_ETX_Channels_Setup(p_channels, channel_id, 0);
+  }
+}
+
+void STX_ETX_Channels_Setup(STX_ETX_Channels_t * p_channels, size_t channel_id, uint8_t config_index)
+{
+  p_channels->p_config_index[channel_id] = config_index;
+
+  STX_ETX_Channels_Reset(p_channels, channel_id);
+}
+
+void STX_ETX_Channels_Reset(STX_ETX_Channels_t * p_channels, size_t channel_id)
+{
+  STX_ETX_t instance;
+
+  STX_ETX_Init(&instance, &p_channels->p_configs[p_channels->p_config_index[channel_id]]);
+  STX_ETX_Channels_Store(p_channels, channel_id, &instance);
+}
+
+#ifdef STX_ETX_STATS
+void STX_ETX_Channels_StatsAttach(STX_ETX_Channels_t * p_channels, STX_ETX_Stats_t * p_stats)
+{
+  if (NULL != p_stats)
+  {
+    memset(p_stats, 0, sizeof(*p_stats));
+  }
+  p_channels->p_stats = p_stats;
+}
+#endif
+
+STX_ETX_Status_t STX_ETX_Channels_DecodeBatch(STX_ETX_Channels_t *     p_channels,
+                                              STX_ETX_Chunk_t const *  p_chunks,
+                                              size_t *                 p_chunks_cnt,
+                                              size_t *                 p_in_offset,
+                                              uint8_t *                p_out,
+                                              size_t *                 p_out_len,
+                                              STX_ETX_ChannelFrame_t * p_frames,
+                                              size_t *                 p_frames_cnt)
+{
+  STX_ETX_Status_t status       = STX_ETX_STATUS_DONE;
+  size_t           chunk_index  = 0;
+  size_t           in_offset    = *p_in_offset;
+  size_t           out_index    = 0;
+  size_t           frames_index = 0;
+
+  for (; chunk_index < *p_chunks_cnt; chunk_index++, in_offset = 0)
+  {
+    STX_ETX_Chunk_t const * p_chunk = &p_chunks[chunk_index];
+    STX_ETX_t               instance;
+
+    STX_ETX_Channels_Load(p_channels, p_chunk->channel_id, &instance);
+
+    while (in_offset < p_chunk->len)
+    {
+      if (frames_index == *p_frames_cnt)
+      {
+        status = STX_ETX_STATUS_OVERFLOW;
+        break;
+      }
+
+      size_t           in_len       = p_chunk->len - in_offset;
+      size_t           out_len      = *p_out_len - out_index;
+      STX_ETX_Status_t frame_status = STX_ETX_Decode(&instance,
+                                                     &p_chunk->p_data[in_offset],
+                                                     &in_len,
+                                                     &p_out[out_index],
+                                                     &out_len);
+
+      if (STX_ETX_IsError(frame_status))
+      {
+        out_len = 0;
+      }
+
+      p_frames[frames_index].channel_id   = p_chunk->channel_id;
+      p_frames[frames_index].frame.offset = out_index;
+      p_frames[frames_index].frame.len    = out_len;
+      p_frames[frames_index].frame.status = frame_status;
+      frames_index++;
+
+      in_offset += in_len;
+      out_index += out_len;
+
+      if (STX_ETX_STATUS_OVERFLOW == frame_status)
+      {
+        status = STX_ETX_STATUS_OVERFLOW;
+        break;
+      }
+    }
+
+    STX_ETX_Channels_Store(p_channels, p_chunk->channel_id, &instance);
+
+    if (STX_ETX_STATUS_OVERFLOW == status)
+    {
+      break;
+    }
+  }
+
+  *p_chunks_cnt = chunk_index;
+  *p_in_offset  = in_offset;
+  *p_out_len    = out_index;
+  *p_frames_cnt = frames_index;
+  return status;
+}
+
+/********************************************
+ * LOCAL FUNCTION DEFINITIONS               *
+ ********************************************/
+
+static void STX_ETX_Channels_Load(STX_ETX_Channels_t const * p_channels,
+                                  size_t                     channel_id,
+                                  STX_ETX_t *                p_instance)
+{
+  p_instance->state          = (STX_ETX_State_t)p_channels->p_state[channel_id];
+  p_instance->computed_crc16 = p_channels->p_computed_crc16[channel_id];
+  p_instance->crc16          = p_channels->p_crc16[channel_id];
+  p_instance->frame_len      = p_channels->p_frame_len[channel_id];
+  p_instance->p_config       = &p_channels->p_configs[p_channels->p_config_index[channel_id]];
+#ifdef STX_ETX_STATS
+  p_instance->p_stats        = p_channels->p_stats;
+#endif
+}
+
+static void STX_ETX_Channels_Store(STX_ETX_Channels_t * p_channels,
+                                   size_t               channel_id,
+                                   STX_ETX_t const *    p_instance)
+{
+  p_channels->p_state[channel_id]          = (uint8_t)p_instance->state;
+  p_channels->p_computed_crc16[channel_id] = p_instance->computed_crc16;
+  p_channels->p_crc16[channel_id]          = p_instance->crc16;
+  p_channels->p_frame_len[channel_id]      = (uint32_t)p_instance->frame_len;
+}
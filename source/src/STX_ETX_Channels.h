@@ -0,0 +1,159 @@
+#ifndef STX_ETX_CHANNELS_H
+#define STX_ETX_CHANNELS_H
+
+/**
+ *  @file STX_ETX_Channels.h
+ *  @brief Header file for STX-ETX Parser channel pool
+ *
+ *         This file contains API of STX-ETX Parser channel pool, which keeps
+ *         state of many channels in dense arrays and shares configurations
+ *         between channels by index.
+ *
+ *  @author Wojciech Jasko
+ */
+
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "STX_ETX.h"
+
+/********************************************
+ * EXPORTED TYPES DEFINITIONS               *
+ ********************************************/
+
+/** @brief STX ETX Channel pool. */
+typedef struct
+{
+  uint32_t *                     p_frame_len;      //!< Number of decoded bytes of current frame of each channel.
+  uint16_t *                     p_computed_crc16; //!< Computed CRC of each channel.
+  uint16_t *                     p_crc16;          //!< Decoded CRC of each channel.
+  uint8_t *                      p_state;          //!< State of each channel.
+  uint8_t *                      p_config_index;   //!< Configuration index of each channel.
+  size_t                         channels_cnt;     //!< Number of channels.
+  STX_ETX_Config_t const *       p_configs;        //!< Pointer to shared configurations.
+#ifdef STX_ETX_STATS
+  STX_ETX_Stats_t *              p_stats;          //!< Pointer to statistics of all channels, NULL if not attached.
+#endif
+} STX_ETX_Channels_t;
+
+
+/** @brief STX ETX Channel input chunk. */
+typedef struct
+{
+  size_t                         channel_id;       //!< Channel identifier.
+  uint8_t const *                p_data;           //!< Pointer to data.
+  size_t                         len;              //!< Data length.
+} STX_ETX_Chunk_t;
+
+
+/** @brief STX ETX Channel frame descriptor. */
+typedef struct
+{
+  size_t                         channel_id;       //!< Channel identifier.
+  STX_ETX_Frame_t                frame;            //!< Frame descriptor.
+} STX_ETX_ChannelFrame_t;
+
+/********************************************
+ * EXPORTED #define CONSTANTS AND MACROS    *
+ ********************************************/
+
+/** @brief Size of storage required by channel pool (aligned to uint32_t). */
+#define STX_ETX_CHANNELS_STORAGE_SIZE(channels_cnt) \
+  ((channels_cnt) * (sizeof(uint32_t) + 2 * sizeof(uint16_t) + 2 * sizeof(uint8_t)))
+
+/********************************************
+ * EXPORTED FUNCTIONS PROTOTYPES            *
+ ********************************************/
+
+/** @brief Initialize STX-ETX Parser channel pool.
+ *
+ *  @note All channels use configuration with index 0. Frame length of each
+ *        channel is stored in 32 bits, so max_frame_len of configurations
+ *        must not exceed UINT32_MAX.
+ *
+ *  @param [out]     p_channels   Pointer to channel pool.
+ *  @param [in]      p_storage    Pointer to storage of STX_ETX_CHANNELS_STORAGE_SIZE(channels_cnt) bytes.
+ *  @param [in]      channels_cnt Number of channels.
+ *  @param [in]      p_configs    Pointer to array of up to 256 shared configurations.
+ *
+ *  @return void.
+ */
+void STX_ETX_Channels_Init(STX_ETX_Channels_t *     p_channels,
+                           void *                   p_storage,
+                           size_t                   channels_cnt,
+                           STX_ETX_Config_t const * p_configs);
+
+
+/** @brief Set configuration of channel and reset it.
+ *
+ *  @param [in,out]  p_channels   Pointer to channel pool.
+ *  @param [in]      channel_id   Channel identifier.
+ *  @param [in]      config_index Index of configuration in shared configurations.
+ *
+ *  @return void.
+ */
+void STX_ETX_Channels_Setup(STX_ETX_Channels_t * p_channels, size_t channel_id, uint8_t config_index);
+
+
+/** @brief Reset channel.
+ *
+ *  @param [in,out]  p_channels   Pointer to channel pool.
+ *  @param [in]      channel_id   Channel identifier.
+ *
+ *  @return void.
+ */
+void STX_ETX_Channels_Reset(STX_ETX_Channels_t * p_channels, size_t channel_id);
+
+
+#ifdef STX_ETX_STATS
+/** @brief Attach statistics to channel pool.
+ *
+ *  @note Statistics are cleared and shared by all channels.
+ *
+ *  @param [in,out]  p_channels   Pointer to channel pool.
+ *  @param [in]      p_stats      Pointer to statistics, NULL to detach.
+ *
+ *  @return void.
+ */
+void STX_ETX_Channels_StatsAttach(STX_ETX_Channels_t * p_channels, STX_ETX_Stats_t * p_stats);
+#endif
+
+
+/** @brief Decode chunks of STX-ETX data received on multiple channels.
+ *
+ *  @note Chunks are decoded in order, each one with state of its channel.
+ *        Frames are described as in STX_ETX_DecodeBatch, frame of each
+ *        chunk may be continued by next chunk of the same channel.
+ *        On OVERFLOW call again with the remaining chunks, updated offset
+ *        and new output buffer.
+ *
+ *  @param [in,out]  p_channels   Pointer to channel pool.
+ *  @param [in]      p_chunks     Pointer to input chunks.
+ *  @param [in,out]  p_chunks_cnt in:  Number of input chunks.
+ *                                out: Number of chunks fully read.
+ *  @param [in,out]  p_in_offset  in:  Number of bytes of first chunk read by previous calls.
+ *                                out: Number of bytes of first not fully read chunk read.
+ *  @param [out]     p_out        Pointer to output buffer.
+ *  @param [in,out]  p_out_len    in:  Output buffer length.
+ *                                out: Number of bytes written to output buffer.
+ *  @param [out]     p_frames     Pointer to frame descriptors.
+ *  @param [in,out]  p_frames_cnt in:  Number of frame descriptors.
+ *                                out: Number of frame descriptors written.
+ *
+ *  @return STX_ETX_Status_t DONE, if all chunks were read, OVERFLOW otherwise.
+ */
+STX_ETX_Status_t STX_ETX_Channels_DecodeBatch(STX_ETX_Channels_t *     p_channels,
+                                              STX_ETX_Chunk_t const *  p_chunks,
+                                              size_t *                 p_chunks_cnt,
+                                              size_t *                 p_in_offset,
+                                              uint8_t *                p_out,
+                                              size_t *                 p_out_len,
+                                              STX_ETX_ChannelFrame_t * p_frames,
+                                              size_t *                 p_frames_cnt);
+
+#endif /* #ifndef STX_ETX_CHANNELS_H */
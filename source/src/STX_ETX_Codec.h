@@ -0,0 +1,535 @@
+#ifndef STX_ETX_CODEC_H
+#define STX_ETX_CODEC_H
+
+/**
+ *  @file STX_ETX_Codec.h
+ *  @brief Header file for STX-ETX Parser specialized codecs
+ *
+ *         This file contains macros generating encode and decode functions
+ *         specialized for CRC function known at compile time (or no CRC),
+ *         so the CRC is called directly (inlined, if its definition is
+ *         visible) instead of through parser configuration. Without CRC the
+ *         decoding reduces to unescaping.
+ *
+ *         Generated functions work as STX_ETX_Decode and STX_ETX_Encode and
+ *         operate on regular parser instance, so both APIs may be mixed for
+ *         instance initialized with <name>_Init.
+ *
+ *  @author Wojciech Jasko
+ */
+
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "STX_ETX.h"
+
+/********************************************
+ * EXPORTED #define CONSTANTS AND MACROS    *
+ ********************************************/
+
+/** @brief Define codec with CRC.
+ *
+ *  @note Defines static configuration <name>_Config and static inline
+ *        functions:
+ *        void             <name>_Init(STX_ETX_t * p_instance);
+ *        STX_ETX_Status_t <name>_Decode(p_instance, p_in, p_in_len, p_out, p_out_len);
+ *        STX_ETX_Status_t <name>_Encode(p_instance, p_in, p_in_len, p_out, p_out_len);
+ *        Statistics (STX_ETX_STATS) are not counted and frame length
+ *        is not limited.
+ *
+ *  @param           name       Codec name (prefix of definitions).
+ *  @param           crc_fn     CRC16 block update function:
+ *                              uint16_t crc_fn(uint16_t crc16, uint8_t const * p_data, size_t len).
+ *  @param           crc_init   Initial value of CRC16.
+ */
+#define STX_ETX_DEFINE_CODEC(name, crc_fn, crc_init)                                             \
+  static const STX_ETX_Config_t name##_Config =                                                  \
+  {                                                                                              \
+    .initial_crc16      = (crc_init),                                                            \
+    .update_crc16       = NULL,                                                                  \
+    .update_crc16_block = (crc_fn),                                                              \
+    .p_crc16_engine     = NULL,                                                                  \
+    .max_frame_len      = 0,                                                                     \
+    .crc_mode           = STX_ETX_CRC_WIRE,                                                      \
+  };                                                                                             \
+  STX_ETX_CODEC_DEFINE_FUNCTIONS(name, (crc_fn), (crc_init), false)
+
+
+/** @brief Define codec with CRC of decoded payload (STX_ETX_CRC_PAYLOAD).
+ *
+ *  @note Defines the same as STX_ETX_DEFINE_CODEC. CRC is computed by one
+ *        call of crc_fn per frame (or per call, if frame is split) over
+ *        unescaped payload, instead of per run and escaped byte.
+ *
+ *  @param           name       Codec name (prefix of definitions).
+ *  @param           crc_fn     CRC16 block update function.
+ *  @param           crc_init   Initial value of CRC16.
+ */
+#define STX_ETX_DEFINE_CODEC_PAYLOAD_CRC(name, crc_fn, crc_init)                                 \
+  static const STX_ETX_Config_t name##_Config =                                                  \
+  {                                                                                              \
+    .initial_crc16      = (crc_init),                                                            \
+    .update_crc16       = NULL,                                                                  \
+    .update_crc16_block = (crc_fn),                                                              \
+    .p_crc16_engine     = NULL,                                                                  \
+    .max_frame_len      = 0,                                                                     \
+    .crc_mode           = STX_ETX_CRC_PAYLOAD,                                                   \
+  };                                                                                             \
+  STX_ETX_CODEC_DEFINE_FUNCTIONS(name, (crc_fn), (crc_init), true)
+
+
+/** @brief Define codec without CRC.
+ *
+ *  @note Defines the same as STX_ETX_DEFINE_CODEC.
+ *
+ *  @param           name       Codec name (prefix of definitions).
+ */
+#define STX_ETX_DEFINE_CODEC_NO_CRC(name)                                                        \
+  static const STX_ETX_Config_t name##_Config =                                                  \
+  {                                                                                              \
+    .initial_crc16      = 0,                                                                     \
+    .update_crc16       = NULL,                                                                  \
+    .update_crc16_block = NULL,                                                                  \
+    .p_crc16_engine     = NULL,                                                                  \
+    .max_frame_len      = 0,                                                                     \
+    .crc_mode           = STX_ETX_CRC_WIRE,                                                      \
+  };                                                                                             \
+  STX_ETX_CODEC_DEFINE_FUNCTIONS(name, NULL, 0, false)
+
+
+/** @brief Define functions of codec (internal). */
+#define STX_ETX_CODEC_DEFINE_FUNCTIONS(name, crc_fn, crc_init, crc_payload)                      \
+  static inline void name##_Init(STX_ETX_t * p_instance)                                         \
+  {                                                                                              \
+    STX_ETX_Init(p_instance, &name##_Config);                                                    \
+  }                                                                                              \
+                                                                                                 \
+  static inline STX_ETX_Status_t name##_Decode(STX_ETX_t *     p_instance,                       \
+                                               uint8_t const * p_in,                             \
+                                               size_t *        p_in_len,                         \
+                                               uint8_t *       p_out,                            \
+                                               size_t *        p_out_len)                        \
+  {                                                                                              \
+    return STX_ETX_CodecDecode(p_instance, p_in, p_in_len, p_out, p_out_len,                      \
+                               crc_fn, crc_init, crc_payload);                                   \
+  }                                                                                              \
+                                                                                                 \
+  static inline STX_ETX_Status_t name##_Encode(STX_ETX_t *     p_instance,                       \
+                                               uint8_t const * p_in,                             \
+                                               size_t *        p_in_len,                         \
+                                               uint8_t *       p_out,                            \
+                                               size_t *        p_out_len)                        \
+  {                                                                                              \
+    return STX_ETX_CodecEncode(p_instance, p_in, p_in_len, p_out, p_out_len,                      \
+                               crc_fn, crc_init, crc_payload);                                   \
+  }
+
+/********************************************
+ * EXPORTED TYPES DEFINITIONS               *
+ ********************************************/
+
+/** @brief CRC16 block update function of codec. */
+typedef uint16_t (*STX_ETX_CodecCRC_t)(uint16_t crc16, uint8_t const * p_data, size_t len);
+
+/********************************************
+ * INLINE FUNCTION DEFINITIONS              *
+ ********************************************/
+
+/** @brief Check if character is special (internal).
+ *
+ *  @param [in]      value    Character.
+ *
+ *  @return bool True, if special character.
+ */
+static inline bool STX_ETX_CodecIsSpecial(uint8_t value)
+{
+  return (STX == value) || (ETX == value) || (DLE == value);
+}
+
+
+/** @brief Decode STX-ETX frame with CRC function known at compile time (internal).
+ *
+ *  @note Works as STX_ETX_Decode. Input and output buffer may be the same.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      p_in       Pointer to input buffer.
+ *  @param [in,out]  p_in_len   in:  Input buffer length.
+ *                              out: Number of bytes read from input buffer.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in,out]  p_out_len  in:  Output buffer length.
+ *                              out: Number of bytes written to output buffer.
+ *  @param [in]      crc_fn      CRC16 block update function, NULL if CRC is not used.
+ *  @param [in]      crc_init    Initial value of CRC16.
+ *  @param [in]      crc_payload True, if CRC covers decoded payload only.
+ *
+ *  @return STX_ETX_Status_t Conversion status.
+ */
+static inline __attribute__((always_inline))
+STX_ETX_Status_t STX_ETX_CodecDecode(STX_ETX_t *        p_instance,
+                                     uint8_t const *    p_in,
+                                     size_t *           p_in_len,
+                                     uint8_t *          p_out,
+                                     size_t *           p_out_len,
+                                     STX_ETX_CodecCRC_t crc_fn,
+                                     uint16_t           crc_init,
+                                     bool               crc_payload)
+{
+  STX_ETX_Status_t status         = STX_ETX_STATUS_CONTINUE;
+  STX_ETX_State_t  state          = p_instance->state;
+  uint16_t         computed_crc16 = p_instance->computed_crc16;
+  uint16_t         crc16          = p_instance->crc16;
+  size_t           in_len         = *p_in_len;
+  size_t           out_len        = *p_out_len;
+  size_t           in_index       = 0;
+  size_t           out_index      = 0;
+
+  while ((in_index < in_len) && (STX_ETX_STATUS_CONTINUE == status))
+  {
+    if (STX_ETX_STATE_DISCARD == state)
+    {
+      uint8_t const * p_stx = (uint8_t const *)memchr(&p_in[in_index], STX, in_len - in_index);
+
+      if (NULL == p_stx)
+      {
+        in_index = in_len;
+        break;
+      }
+
+      in_index = (size_t)(p_stx - p_in);
+      state    = STX_ETX_STATE_IDLE;
+    }
+
+    if (STX_ETX_STATE_STARTED == state)
+    {
+      size_t max_len = in_len - in_index;
+
+      if (max_len > out_len - out_index)
+      {
+        max_len = out_len - out_index;
+      }
+
+      size_t run_len = STX_ETX_FindSpecial(&p_in[in_index], max_len);
+
+      if (0 != run_len)
+      {
+        if ((NULL != crc_fn) && !crc_payload)
+        {
+          computed_crc16 = crc_fn(computed_crc16, &p_in[in_index], run_len);
+        }
+
+        memmove(&p_out[out_index], &p_in[in_index], run_len);
+        in_index  += run_len;
+        out_index += run_len;
+
+        if (in_index == in_len)
+        {
+          break;
+        }
+      }
+    }
+
+    uint8_t value = p_in[in_index];
+
+    switch (state)
+    {
+      case STX_ETX_STATE_IDLE:
+        if (STX != value)
+        {
+          status = STX_ETX_STATUS_INV_CHAR;
+          break;
+        }
+
+        state = STX_ETX_STATE_STARTED;
+        break;
+
+      case STX_ETX_STATE_STARTED:
+        if (DLE == value)
+        {
+          state = STX_ETX_STATE_DLE_LATCHED;
+        }
+        else if (ETX == value)
+        {
+          /* Call decodes at most one frame, so its payload starts at the beginning of output. */
+          if ((NULL != crc_fn) && crc_payload)
+          {
+            computed_crc16 = crc_fn(computed_crc16, p_out, out_index);
+          }
+
+          state  = (NULL != crc_fn) ? STX_ETX_STATE_CRC_BYTE_0 : STX_ETX_STATE_IDLE;
+          status = (NULL != crc_fn) ? STX_ETX_STATUS_CONTINUE : STX_ETX_STATUS_DONE;
+        }
+        else if (STX == value)
+        {
+          status = STX_ETX_STATUS_INV_CHAR;
+        }
+        else
+        {
+          /* Not special character is left only if output buffer is full. */
+          status = STX_ETX_STATUS_OVERFLOW;
+        }
+        break;
+
+      case STX_ETX_STATE_DLE_LATCHED:
+        if (!STX_ETX_CodecIsSpecial(value))
+        {
+          status = STX_ETX_STATUS_INV_CHAR;
+        }
+        else if (out_index == out_len)
+        {
+          status = STX_ETX_STATUS_OVERFLOW;
+        }
+        else
+        {
+          p_out[out_index++] = value;
+          state              = STX_ETX_STATE_STARTED;
+        }
+        break;
+
+      case STX_ETX_STATE_CRC_BYTE_0:
+        crc16 = value;
+        state = STX_ETX_STATE_CRC_BYTE_1;
+        break;
+
+      default:
+        crc16 |= (uint16_t)value << 8;
+        state  = STX_ETX_STATE_IDLE;
+        status = (crc16 != computed_crc16) ? STX_ETX_STATUS_INV_CRC : STX_ETX_STATUS_DONE;
+        break;
+    }
+
+    if (STX_ETX_STATUS_OVERFLOW != status)
+    {
+      /* CRC bytes change state to CRC_BYTE_1 or IDLE, CRC of invalid frame is not used. */
+      if ((NULL != crc_fn) && !crc_payload && (STX_ETX_STATE_CRC_BYTE_1 != state) && (STX_ETX_STATE_IDLE != state))
+      {
+        computed_crc16 = crc_fn(computed_crc16, &value, 1);
+      }
+      in_index++;
+    }
+  }
+
+  if ((STX_ETX_STATUS_OVERFLOW != status) && (STX_ETX_STATUS_CONTINUE != status))
+  {
+    state = STX_ETX_STATE_IDLE;
+
+    if (NULL != crc_fn)
+    {
+      computed_crc16 = crc_init;
+    }
+  }
+  else if ((NULL != crc_fn) && crc_payload && ((STX_ETX_STATE_STARTED == state) || (STX_ETX_STATE_DLE_LATCHED == state)))
+  {
+    computed_crc16 = crc_fn(computed_crc16, p_out, out_index);
+  }
+
+  p_instance->state          = state;
+  p_instance->computed_crc16 = computed_crc16;
+  p_instance->crc16          = crc16;
+  p_instance->frame_len      = (STX_ETX_STATE_IDLE == state) ? 0 : (p_instance->frame_len + out_index);
+
+  *p_in_len  = in_index;
+  *p_out_len = out_index;
+  return status;
+}
+
+
+/** @brief Encode STX-ETX frame with CRC function known at compile time (internal).
+ *
+ *  @note Works as STX_ETX_Encode.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      p_in       Pointer to input buffer.
+ *  @param [in,out]  p_in_len   in:  Input buffer length.
+ *                              out: Number of bytes read from input buffer.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in,out]  p_out_len  in:  Output buffer length.
+ *                              out: Number of bytes written to output buffer.
+ *  @param [in]      crc_fn      CRC16 block update function, NULL if CRC is not used.
+ *  @param [in]      crc_init    Initial value of CRC16.
+ *  @param [in]      crc_payload True, if CRC covers decoded payload only.
+ *
+ *  @return STX_ETX_Status_t Conversion status.
+ */
+static inline __attribute__((always_inline))
+STX_ETX_Status_t STX_ETX_CodecEncode(STX_ETX_t *        p_instance,
+                                     uint8_t const *    p_in,
+                                     size_t *           p_in_len,
+                                     uint8_t *          p_out,
+                                     size_t *           p_out_len,
+                                     STX_ETX_CodecCRC_t crc_fn,
+                                     uint16_t           crc_init,
+                                     bool               crc_payload)
+{
+  STX_ETX_Status_t status         = STX_ETX_STATUS_CONTINUE;
+  STX_ETX_State_t  state          = p_instance->state;
+  uint16_t         computed_crc16 = p_instance->computed_crc16;
+  size_t           in_len         = *p_in_len;
+  size_t           out_len        = *p_out_len;
+  size_t           in_index       = 0;
+  size_t           out_index      = 0;
+
+  if (STX_ETX_STATE_IDLE == state)
+  {
+    if (out_index == out_len)
+    {
+      status = STX_ETX_STATUS_OVERFLOW;
+    }
+    else
+    {
+      p_out[out_index++] = STX;
+      state              = STX_ETX_STATE_STARTED;
+
+      if ((NULL != crc_fn) && !crc_payload)
+      {
+        uint8_t value = STX;
+        computed_crc16 = crc_fn(computed_crc16, &value, 1);
+      }
+    }
+  }
+
+  while ((in_index < in_len) && (STX_ETX_STATUS_CONTINUE == status))
+  {
+    if (STX_ETX_STATE_STARTED == state)
+    {
+      size_t max_len = in_len - in_index;
+
+      if (max_len > out_len - out_index)
+      {
+        max_len = out_len - out_index;
+      }
+
+      size_t run_len = STX_ETX_FindSpecial(&p_in[in_index], max_len);
+
+      if (0 != run_len)
+      {
+        memcpy(&p_out[out_index], &p_in[in_index], run_len);
+
+        if ((NULL != crc_fn) && !crc_payload)
+        {
+          computed_crc16 = crc_fn(computed_crc16, &p_in[in_index], run_len);
+        }
+
+        in_index  += run_len;
+        out_index += run_len;
+
+        if (in_index == in_len)
+        {
+          break;
+        }
+      }
+    }
+
+    uint8_t value = p_in[in_index];
+
+    if (STX_ETX_CodecIsSpecial(value) && (STX_ETX_STATE_STARTED == state))
+    {
+      if (out_index == out_len)
+      {
+        status = STX_ETX_STATUS_OVERFLOW;
+        break;
+      }
+
+      p_out[out_index++] = DLE;
+      state              = STX_ETX_STATE_DLE_LATCHED;
+
+      if ((NULL != crc_fn) && !crc_payload)
+      {
+        uint8_t escape = DLE;
+        computed_crc16 = crc_fn(computed_crc16, &escape, 1);
+      }
+    }
+
+    if (out_index == out_len)
+    {
+      status = STX_ETX_STATUS_OVERFLOW;
+      break;
+    }
+
+    p_out[out_index++] = value;
+    in_index++;
+
+    if (STX_ETX_CodecIsSpecial(value))
+    {
+      state = STX_ETX_STATE_STARTED;
+    }
+
+    if ((NULL != crc_fn) && !crc_payload)
+    {
+      computed_crc16 = crc_fn(computed_crc16, &value, 1);
+    }
+  }
+
+  /* Payload read by this call is covered at once, before CRC bytes may be written. */
+  if ((NULL != crc_fn) && crc_payload)
+  {
+    computed_crc16 = crc_fn(computed_crc16, p_in, in_index);
+  }
+
+  if ((STX_ETX_STATUS_CONTINUE == status) && (STX_ETX_STATE_STARTED == state))
+  {
+    if (out_index == out_len)
+    {
+      status = STX_ETX_STATUS_OVERFLOW;
+    }
+    else
+    {
+      uint8_t value = ETX;
+
+      p_out[out_index++] = value;
+      state              = (NULL != crc_fn) ? STX_ETX_STATE_CRC_BYTE_0 : STX_ETX_STATE_IDLE;
+      status             = (NULL != crc_fn) ? STX_ETX_STATUS_CONTINUE : STX_ETX_STATUS_DONE;
+
+      if ((NULL != crc_fn) && !crc_payload)
+      {
+        computed_crc16 = crc_fn(computed_crc16, &value, 1);
+      }
+    }
+  }
+
+  if ((STX_ETX_STATUS_CONTINUE == status) && (STX_ETX_STATE_CRC_BYTE_0 == state))
+  {
+    if (out_index == out_len)
+    {
+      status = STX_ETX_STATUS_OVERFLOW;
+    }
+    else
+    {
+      p_out[out_index++] = (uint8_t)(computed_crc16 & UINT8_MAX);
+      state              = STX_ETX_STATE_CRC_BYTE_1;
+    }
+  }
+
+  if ((STX_ETX_STATUS_CONTINUE == status) && (STX_ETX_STATE_CRC_BYTE_1 == state))
+  {
+    if (out_index == out_len)
+    {
+      status = STX_ETX_STATUS_OVERFLOW;
+    }
+    else
+    {
+      p_out[out_index++] = (uint8_t)(computed_crc16 >> 8);
+      state              = STX_ETX_STATE_IDLE;
+      status             = STX_ETX_STATUS_DONE;
+    }
+  }
+
+  if ((STX_ETX_STATUS_DONE == status) && (NULL != crc_fn))
+  {
+    computed_crc16 = crc_init;
+  }
+
+  p_instance->state          = state;
+  p_instance->computed_crc16 = computed_crc16;
+
+  *p_in_len  = in_index;
+  *p_out_len = out_index;
+  return status;
+}
+
+#endif /* #ifndef STX_ETX_CODEC_H */
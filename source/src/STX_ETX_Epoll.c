@@ -0,0 +1,264 @@
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+#include "STX_ETX_Epoll.h"
+
+/********************************************
+ * LOCAL FUNCTIONS PROTOTYPES               *
+ ********************************************/
+
+/** @brief Read source until it is drained or read limit is reached.
+ *
+ *  @param [in,out]  p_epoll    Pointer to loop.
+ *  @param [in,out]  p_source   Pointer to source.
+ *
+ *  @return bool  True, if source may have more data.
+ */
+static bool STX_ETX_Epoll_Read(STX_ETX_Epoll_t * p_epoll, STX_ETX_EpollSource_t * p_source);
+
+
+/** @brief Decode data read from source.
+ *
+ *  @param [in,out]  p_epoll    Pointer to loop.
+ *  @param [in,out]  p_source   Pointer to source.
+ *  @param [in]      p_in       Pointer to data.
+ *  @param [in]      in_len     Data length.
+ *
+ *  @return void.
+ */
+static void STX_ETX_Epoll_Decode(STX_ETX_Epoll_t *       p_epoll,
+                                 STX_ETX_EpollSource_t * p_source,
+                                 uint8_t const *         p_in,
+                                 size_t                  in_len);
+
+
+/** @brief Remove source after end of file or read error and notify user.
+ *
+ *  @param [in,out]  p_epoll    Pointer to loop.
+ *  @param [in,out]  p_source   Pointer to source.
+ *  @param [in]      error      0 on end of file, errno otherwise.
+ *
+ *  @return void.
+ */
+static void STX_ETX_Epoll_Closed(STX_ETX_Epoll_t * p_epoll, STX_ETX_EpollSource_t * p_source, int error);
+
+/********************************************
+ * EXPORTED FUNCTION DEFINITIONS            *
+ ********************************************/
+
+bool STX_ETX_Epoll_Init(STX_ETX_Epoll_t *    p_epoll,
+                        uint8_t *            p_buf,
+                        size_t               buf_size,
+                        STX_ETX_EpollFrame_t on_frame,
+                        STX_ETX_EpollClose_t on_close,
+                        void *               p_context)
+{
+  p_epoll->epoll_fd  = epoll_create1(EPOLL_CLOEXEC);
+  p_epoll->p_buf     = p_buf;
+  p_epoll->buf_size  = buf_size;
+  p_epoll->p_ready   = NULL;
+  p_epoll->on_frame  = on_frame;
+  p_epoll->on_close  = on_close;
+  p_epoll->p_context = p_context;
+
+  return p_epoll->epoll_fd >= 0;
+}
+
+void STX_ETX_Epoll_Close(STX_ETX_Epoll_t * p_epoll)
+{
+  close(p_epoll->epoll_fd);
+  p_epoll->epoll_fd = -1;
+  p_epoll->p_ready  = NULL;
+}
+
+bool STX_ETX_Epoll_Add(STX_ETX_Epoll_t *        p_epoll,
+                       STX_ETX_EpollSource_t *  p_source,
+                       int                      fd,
+                       STX_ETX_Config_t const * p_config,
+                       uint8_t *                p_frame,
+                       size_t                   frame_size)
+{
+  int flags = fcntl(fd, F_GETFL);
+
+  if ((flags < 0) || (fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0))
+  {
+    return false;
+  }
+
+  memset(p_source, 0, sizeof(*p_source));
+  p_source->fd         = fd;
+  p_source->is_open    = true;
+  STX_ETX_Source_Init(&p_source->source, p_config, p_frame, frame_size);
+
+  /* Source already readable is reported by the first wait. */
+  struct epoll_event event =
+  {
+    .events   = EPOLLIN | EPOLLRDHUP | EPOLLET,
+    .data.ptr = p_source,
+  };
+
+  if (epoll_ctl(p_epoll->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+  {
+    p_source->is_open = false;
+    return false;
+  }
+  return true;
+}
+
+void STX_ETX_Epoll_Remove(STX_ETX_Epoll_t * p_epoll, STX_ETX_EpollSource_t * p_source)
+{
+  epoll_ctl(p_epoll->epoll_fd, EPOLL_CTL_DEL, p_source->fd, NULL);
+  p_source->is_open = false;
+
+  /* Source taken by running loop is skipped there. */
+  for (STX_ETX_EpollSource_t ** pp_next = &p_epoll->p_ready; NULL != *pp_next; pp_next = &(*pp_next)->p_next)
+  {
+    if (*pp_next == p_source)
+    {
+      *pp_next           = p_source->p_next;
+      p_source->is_ready = false;
+      break;
+    }
+  }
+}
+
+int STX_ETX_Epoll_Run(STX_ETX_Epoll_t * p_epoll, int timeout_ms)
+{
+  struct epoll_event events[STX_ETX_EPOLL_EVENTS_MAX];
+  int                events_cnt = epoll_wait(p_epoll->epoll_fd,
+                                             events,
+                                             STX_ETX_EPOLL_EVENTS_MAX,
+                                             (NULL != p_epoll->p_ready) ? 0 : timeout_ms);
+
+  if (events_cnt < 0)
+  {
+    if (EINTR != errno)
+    {
+      return -1;
+    }
+    events_cnt = 0;
+  }
+
+  for (int index = 0; index < events_cnt; index++)
+  {
+    STX_ETX_EpollSource_t * p_source = (STX_ETX_EpollSource_t *)events[index].data.ptr;
+
+    if (0 != (events[index].events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)))
+    {
+      p_source->is_hangup = true;
+    }
+
+    if (!p_source->is_ready)
+    {
+      p_source->is_ready = true;
+      p_source->p_next   = p_epoll->p_ready;
+      p_epoll->p_ready   = p_source;
+    }
+  }
+
+  /* Sources not drained by this run are collected again for the next one. */
+  STX_ETX_EpollSource_t * p_source    = p_epoll->p_ready;
+  int                     sources_cnt = 0;
+
+  p_epoll->p_ready = NULL;
+
+  while (NULL != p_source)
+  {
+    STX_ETX_EpollSource_t * p_next = p_source->p_next;
+
+    p_source->is_ready = false;
+
+    if (p_source->is_open)
+    {
+      sources_cnt++;
+
+      if (STX_ETX_Epoll_Read(p_epoll, p_source) && p_source->is_open && !p_source->is_ready)
+      {
+        p_source->is_ready = true;
+        p_source->p_next   = p_epoll->p_ready;
+        p_epoll->p_ready   = p_source;
+      }
+    }
+    p_source = p_next;
+  }
+  return sources_cnt;
+}
+
+/********************************************
+ * LOCAL FUNCTION DEFINITIONS               *
+ ********************************************/
+
+static bool STX_ETX_Epoll_Read(STX_ETX_Epoll_t * p_epoll, STX_ETX_EpollSource_t * p_source)
+{
+  for (size_t reads_cnt = 0; reads_cnt < STX_ETX_EPOLL_READS_MAX; reads_cnt++)
+  {
+    ssize_t len = read(p_source->fd, p_epoll->p_buf, p_epoll->buf_size);
+
+    if (len < 0)
+    {
+      if (EINTR == errno)
+      {
+        continue;
+      }
+
+      if ((EAGAIN != errno) && (EWOULDBLOCK != errno))
+      {
+        STX_ETX_Epoll_Closed(p_epoll, p_source, errno);
+      }
+      return false;
+    }
+
+    if (0 == len)
+    {
+      STX_ETX_Epoll_Closed(p_epoll, p_source, 0);
+      return false;
+    }
+
+    STX_ETX_Epoll_Decode(p_epoll, p_source, p_epoll->p_buf, (size_t)len);
+
+    /* Short read drained the source, data arriving later triggers new edge.
+     * Hang up has no further edge, so end of file must be read now. */
+    if (!p_source->is_open || (((size_t)len < p_epoll->buf_size) && !p_source->is_hangup))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void STX_ETX_Epoll_Decode(STX_ETX_Epoll_t *       p_epoll,
+                                 STX_ETX_EpollSource_t * p_source,
+                                 uint8_t const *         p_in,
+                                 size_t                  in_len)
+{
+  size_t in_index = 0;
+
+  while ((in_index < in_len) && p_source->is_open)
+  {
+    size_t chunk_len = in_len - in_index;
+
+    if (STX_ETX_STATUS_DONE == STX_ETX_Source_Decode(&p_source->source, &p_in[in_index], &chunk_len))
+    {
+      p_epoll->on_frame(p_epoll->p_context, p_source, p_source->source.p_frame, p_source->source.frame_len);
+    }
+    in_index += chunk_len;
+  }
+}
+
+static void STX_ETX_Epoll_Closed(STX_ETX_Epoll_t * p_epoll, STX_ETX_EpollSource_t * p_source, int error)
+{
+  STX_ETX_Epoll_Remove(p_epoll, p_source);
+  p_source->error = error;
+
+  if (NULL != p_epoll->on_close)
+  {
+    p_epoll->on_close(p_epoll->p_context, p_source);
+  }
+}
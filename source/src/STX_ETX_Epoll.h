@@ -0,0 +1,171 @@
+#ifndef STX_ETX_EPOLL_H
+#define STX_ETX_EPOLL_H
+
+/**
+ *  @file STX_ETX_Epoll.h
+ *  @brief Header file for STX-ETX Parser epoll ingest loop
+ *
+ *         This file contains API of edge-triggered epoll loop, which reads
+ *         many file descriptors (ttys, ptys, pipes, sockets) with large
+ *         non-blocking reads and decodes data of each one with its own
+ *         parser instance. Finished frames are passed to callback.
+ *         Linux only, built with STX_ETX_IO option.
+ *
+ *  @author Wojciech Jasko
+ */
+
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "STX_ETX.h"
+#include "STX_ETX_Source.h"
+
+/********************************************
+ * EXPORTED #define CONSTANTS AND MACROS    *
+ ********************************************/
+
+#define STX_ETX_EPOLL_EVENTS_MAX  64  /** Maximal number of events taken by one wait. */
+#define STX_ETX_EPOLL_READS_MAX   16  /** Maximal number of reads of source per run, others wait for next run. */
+
+/********************************************
+ * EXPORTED TYPES DEFINITIONS               *
+ ********************************************/
+
+/** @brief STX ETX Epoll source (file descriptor with its parser). */
+typedef struct STX_ETX_EpollSource_s
+{
+  int                            fd;              //!< File descriptor.
+  int                            error;           //!< 0 on end of file, errno of failed read otherwise (valid, when closed).
+  bool                           is_open;         //!< True, until end of file or read error.
+  bool                           is_ready;        //!< True, if source is in list of sources not read to the end.
+  bool                           is_hangup;       //!< True, if peer hung up, source is read until end of file.
+  STX_ETX_Source_t               source;          //!< Parser with frame buffer.
+  struct STX_ETX_EpollSource_s * p_next;          //!< Next source not read to the end.
+  void *                         p_user;          //!< User data.
+} STX_ETX_EpollSource_t;
+
+
+/** @brief  Frame callback.
+ *
+ *  @param  p_context   Callback context.
+ *  @param  p_source    Pointer to source.
+ *  @param  p_data      Pointer to frame payload (valid until callback returns).
+ *  @param  len         Payload length.
+ **/
+typedef void (*STX_ETX_EpollFrame_t)(void *                  p_context,
+                                     STX_ETX_EpollSource_t * p_source,
+                                     uint8_t const *         p_data,
+                                     size_t                  len);
+
+
+/** @brief  Close callback.
+ *
+ *  @note Source is already removed from the loop, error field tells the reason.
+ *
+ *  @param  p_context   Callback context.
+ *  @param  p_source    Pointer to source.
+ **/
+typedef void (*STX_ETX_EpollClose_t)(void * p_context, STX_ETX_EpollSource_t * p_source);
+
+
+/** @brief STX ETX Epoll loop. */
+typedef struct
+{
+  int                            epoll_fd;        //!< Epoll file descriptor.
+  uint8_t *                      p_buf;           //!< Pointer to read buffer shared by sources.
+  size_t                         buf_size;        //!< Read buffer size.
+  STX_ETX_EpollSource_t *        p_ready;         //!< First source not read to the end.
+  STX_ETX_EpollFrame_t           on_frame;        //!< Frame callback.
+  STX_ETX_EpollClose_t           on_close;        //!< Close callback, NULL if not used.
+  void *                         p_context;       //!< Callbacks context.
+} STX_ETX_Epoll_t;
+
+/********************************************
+ * EXPORTED FUNCTIONS PROTOTYPES            *
+ ********************************************/
+
+/** @brief Initialize epoll loop.
+ *
+ *  @param [out]     p_epoll    Pointer to loop.
+ *  @param [in]      p_buf      Pointer to read buffer (large, e.g. 64 KiB).
+ *  @param [in]      buf_size   Read buffer size.
+ *  @param [in]      on_frame   Frame callback.
+ *  @param [in]      on_close   Close callback, NULL if not used.
+ *  @param [in]      p_context  Callbacks context.
+ *
+ *  @return bool  True, if succeeded.
+ */
+bool STX_ETX_Epoll_Init(STX_ETX_Epoll_t *    p_epoll,
+                        uint8_t *            p_buf,
+                        size_t               buf_size,
+                        STX_ETX_EpollFrame_t on_frame,
+                        STX_ETX_EpollClose_t on_close,
+                        void *               p_context);
+
+
+/** @brief Close epoll loop.
+ *
+ *  @note File descriptors of sources are not closed.
+ *
+ *  @param [in,out]  p_epoll    Pointer to loop.
+ *
+ *  @return void.
+ */
+void STX_ETX_Epoll_Close(STX_ETX_Epoll_t * p_epoll);
+
+
+/** @brief Add file descriptor to epoll loop.
+ *
+ *  @note File descriptor is switched to non-blocking mode. Frame longer than
+ *        frame buffer is dropped (counted as too long), set max_frame_len of
+ *        configuration to frame buffer size to reject it early.
+ *
+ *  @param [in,out]  p_epoll    Pointer to loop.
+ *  @param [out]     p_source   Pointer to source (kept until removed).
+ *  @param [in]      fd         File descriptor.
+ *  @param [in]      p_config   Pointer to parser configuration.
+ *  @param [in]      p_frame    Pointer to frame buffer.
+ *  @param [in]      frame_size Frame buffer size.
+ *
+ *  @return bool  True, if succeeded.
+ */
+bool STX_ETX_Epoll_Add(STX_ETX_Epoll_t *        p_epoll,
+                       STX_ETX_EpollSource_t *  p_source,
+                       int                      fd,
+                       STX_ETX_Config_t const * p_config,
+                       uint8_t *                p_frame,
+                       size_t                   frame_size);
+
+
+/** @brief Remove source from epoll loop.
+ *
+ *  @note File descriptor is not closed.
+ *
+ *  @param [in,out]  p_epoll    Pointer to loop.
+ *  @param [in,out]  p_source   Pointer to source.
+ *
+ *  @return void.
+ */
+void STX_ETX_Epoll_Remove(STX_ETX_Epoll_t * p_epoll, STX_ETX_EpollSource_t * p_source);
+
+
+/** @brief Wait for ready sources, read and decode them.
+ *
+ *  @note Ready source is read until read returns less than buffer size or
+ *        STX_ETX_EPOLL_READS_MAX reads are done; then it is kept ready and
+ *        continued by next run (without waiting), so busy sources do not
+ *        starve others. Source hung up by peer is read until end of file.
+ *
+ *  @param [in,out]  p_epoll    Pointer to loop.
+ *  @param [in]      timeout_ms Wait timeout in milliseconds, -1 to wait forever.
+ *
+ *  @return int Number of sources read, -1 if wait failed (errno is set).
+ */
+int STX_ETX_Epoll_Run(STX_ETX_Epoll_t * p_epoll, int timeout_ms);
+
+#endif /* #ifndef STX_ETX_EPOLL_H */
@@ -0,0 +1,330 @@
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "STX_ETX_Parallel.h"
+
+/********************************************
+ * LOCAL TYPES DEFINITIONS                  *
+ ********************************************/
+
+/** @brief Frame decoded by worker. */
+typedef struct
+{
+  size_t                         in_offset;       //!< Offset of frame in input buffer.
+  size_t                         in_len;          //!< Number of input bytes of frame.
+  STX_ETX_State_t                state;           //!< Worker parser state at the beginning of frame.
+  STX_ETX_Frame_t                frame;           //!< Frame descriptor (offset in output buffer).
+} STX_ETX_Record_t;
+
+
+/** @brief Worker decoding one chunk of input. */
+typedef struct
+{
+  STX_ETX_t                      instance;        //!< Parser instance.
+  uint8_t const *                p_in;            //!< Pointer to input buffer.
+  uint8_t *                      p_out;           //!< Pointer to output buffer.
+  size_t                         in_start;        //!< Offset of first byte of chunk.
+  size_t                         in_end;          //!< Offset of first byte after chunk.
+  STX_ETX_Record_t *             p_records;       //!< Decoded frames.
+  size_t                         records_cnt;     //!< Number of decoded frames.
+  size_t                         records_size;    //!< Capacity of decoded frames.
+  pthread_t                      thread;          //!< Thread.
+  bool                           is_thread;       //!< True, if thread was started.
+} STX_ETX_Worker_t;
+
+/********************************************
+ * LOCAL FUNCTIONS PROTOTYPES               *
+ ********************************************/
+
+/** @brief Decode chunk of input speculatively.
+ *
+ *  @note Output is written at the offset of chunk in input buffer. Worker
+ *        without frames is left, if memory allocation fails.
+ *
+ *  @param [in,out]  p_arg    Pointer to worker.
+ *
+ *  @return void * NULL.
+ */
+static void * STX_ETX_WorkerRun(void * p_arg);
+
+
+/** @brief Append frame to worker.
+ *
+ *  @param [in,out]  p_worker Pointer to worker.
+ *  @param [in]      p_record Pointer to frame.
+ *
+ *  @return bool True, if succeeded.
+ */
+static bool STX_ETX_WorkerAppend(STX_ETX_Worker_t * p_worker, STX_ETX_Record_t const * p_record);
+
+/********************************************
+ * EXPORTED FUNCTION DEFINITIONS            *
+ ********************************************/
+
+STX_ETX_Status_t STX_ETX_DecodeParallel(STX_ETX_t *       p_instance,
+                                       uint8_t const *   p_in,
+                                       size_t *          p_in_len,
+                                       uint8_t *         p_out,
+                                       size_t *          p_out_len,
+                                       STX_ETX_Frame_t * p_frames,
+                                       size_t *          p_frames_cnt,
+                                       size_t            threads_cnt)
+{
+  size_t in_len = *p_in_len;
+
+  if (0 == threads_cnt)
+  {
+    long cpus_cnt = sysconf(_SC_NPROCESSORS_ONLN);
+
+    threads_cnt = (cpus_cnt > 0) ? (size_t)cpus_cnt : 1;
+  }
+
+  if (threads_cnt > in_len / STX_ETX_PARALLEL_MIN_CHUNK_LEN)
+  {
+    threads_cnt = in_len / STX_ETX_PARALLEL_MIN_CHUNK_LEN;
+  }
+
+  STX_ETX_Worker_t * p_workers = NULL;
+
+  if ((threads_cnt > 1) && (*p_out_len >= in_len))
+  {
+    p_workers = calloc(threads_cnt, sizeof(STX_ETX_Worker_t));
+  }
+
+  if (NULL == p_workers)
+  {
+    return STX_ETX_DecodeBatch(p_instance, p_in, p_in_len, p_out, p_out_len, p_frames, p_frames_cnt);
+  }
+
+  /* Split input at STX characters. First chunk continues frame of instance. */
+  for (size_t k = 0; k < threads_cnt; k++)
+  {
+    STX_ETX_Worker_t * p_worker = &p_workers[k];
+    size_t             split    = in_len / threads_cnt * k;
+    uint8_t const *    p_stx    = memchr(&p_in[split], STX, in_len - split);
+
+    p_worker->in_start = (0 == k) ? 0 : ((NULL != p_stx) ? (size_t)(p_stx - p_in) : in_len);
+    p_worker->p_in     = p_in;
+    p_worker->p_out    = p_out;
+
+    if (0 == k)
+    {
+      p_worker->instance = *p_instance;
+    }
+    else
+    {
+      STX_ETX_Init(&p_worker->instance, p_instance->p_config);
+      p_workers[k - 1].in_end = p_worker->in_start;
+    }
+#ifdef STX_ETX_STATS
+    /* Speculative decoding is not counted. */
+    p_worker->instance.p_stats = NULL;
+#endif
+  }
+  p_workers[threads_cnt - 1].in_end = in_len;
+
+  for (size_t k = 1; k < threads_cnt; k++)
+  {
+    p_workers[k].is_thread = (0 == pthread_create(&p_workers[k].thread, NULL, STX_ETX_WorkerRun, &p_workers[k]));
+  }
+
+  for (size_t k = 0; k < threads_cnt; k++)
+  {
+    if (p_workers[k].is_thread)
+    {
+      pthread_join(p_workers[k].thread, NULL);
+    }
+    else
+    {
+      STX_ETX_WorkerRun(&p_workers[k]);
+    }
+  }
+
+  /* Stitch chunks. Frames of worker are accepted from the first one, which
+   * starts where serial decoding is idle (or discards too long frame) and
+   * worker was in the same state, as long as their output was not overwritten
+   * (also by dropped output of invalid frames). Otherwise frames are decoded
+   * serially. */
+  STX_ETX_Status_t status       = STX_ETX_STATUS_CONTINUE;
+  STX_ETX_t        serial       = *p_instance;
+  size_t           in_index     = 0;
+  size_t           out_index    = 0;
+  size_t           frames_index = 0;
+  size_t           dirty_index  = 0;
+
+  for (size_t k = 0; (k < threads_cnt) && (STX_ETX_STATUS_OVERFLOW != status); k++)
+  {
+    STX_ETX_Worker_t const * p_worker    = &p_workers[k];
+    size_t                   records_cnt = p_worker->records_cnt;
+    size_t                   index       = 0;
+
+    /* Frame not finished within chunk is decoded serially. */
+    if ((k != threads_cnt - 1) && (0 != records_cnt) &&
+        (STX_ETX_STATUS_CONTINUE == p_worker->p_records[records_cnt - 1].frame.status))
+    {
+      records_cnt--;
+    }
+
+    while (in_index < p_worker->in_end)
+    {
+      if (frames_index == *p_frames_cnt)
+      {
+        status = STX_ETX_STATUS_OVERFLOW;
+        break;
+      }
+
+      while ((index < records_cnt) && (p_worker->p_records[index].in_offset < in_index))
+      {
+        index++;
+      }
+
+      STX_ETX_Record_t const * p_record = (index < records_cnt) ? &p_worker->p_records[index] : NULL;
+
+      if ((NULL != p_record) &&
+          (p_record->in_offset == in_index) &&
+          (p_record->frame.offset >= dirty_index) &&
+          (p_record->state == serial.state) &&
+          ((STX_ETX_STATE_IDLE == serial.state) || (STX_ETX_STATE_DISCARD == serial.state) || (0 == in_index)))
+      {
+        memmove(&p_out[out_index], &p_out[p_record->frame.offset], p_record->frame.len);
+
+        status = p_record->frame.status;
+        p_frames[frames_index].offset = out_index;
+        p_frames[frames_index].len    = p_record->frame.len;
+        p_frames[frames_index].status = status;
+        frames_index++;
+
+        in_index  += p_record->in_len;
+        out_index += p_record->frame.len;
+        index++;
+
+        if (dirty_index < out_index)
+        {
+          dirty_index = out_index;
+        }
+
+        if (STX_ETX_STATUS_CONTINUE == status)
+        {
+          serial = p_worker->instance;
+#ifdef STX_ETX_STATS
+          serial.p_stats = p_instance->p_stats;
+#endif
+        }
+        else
+        {
+          STX_ETX_Reset(&serial);
+
+          if (STX_ETX_STATUS_TOO_LONG == status)
+          {
+            serial.state = STX_ETX_STATE_DISCARD;
+          }
+        }
+      }
+      else
+      {
+        size_t frame_in_len  = in_len - in_index;
+        size_t frame_out_len = *p_out_len - out_index;
+
+        status = STX_ETX_Decode(&serial, &p_in[in_index], &frame_in_len, &p_out[out_index], &frame_out_len);
+
+        if (dirty_index < out_index + frame_out_len)
+        {
+          dirty_index = out_index + frame_out_len;
+        }
+
+        if (STX_ETX_IsError(status))
+        {
+          frame_out_len = 0;
+        }
+
+        p_frames[frames_index].offset = out_index;
+        p_frames[frames_index].len    = frame_out_len;
+        p_frames[frames_index].status = status;
+        frames_index++;
+
+        in_index  += frame_in_len;
+        out_index += frame_out_len;
+      }
+    }
+  }
+
+  for (size_t k = 0; k < threads_cnt; k++)
+  {
+    free(p_workers[k].p_records);
+  }
+  free(p_workers);
+
+  *p_instance   = serial;
+  *p_in_len     = in_index;
+  *p_out_len    = out_index;
+  *p_frames_cnt = frames_index;
+  return status;
+}
+
+/********************************************
+ * LOCAL FUNCTION DEFINITIONS               *
+ ********************************************/
+
+static void * STX_ETX_WorkerRun(void * p_arg)
+{
+  STX_ETX_Worker_t * p_worker  = p_arg;
+  size_t             in_index  = p_worker->in_start;
+  size_t             out_index = p_worker->in_start;
+
+  while (in_index < p_worker->in_end)
+  {
+    STX_ETX_Record_t record;
+
+    record.in_offset    = in_index;
+    record.in_len       = p_worker->in_end - in_index;
+    record.state        = p_worker->instance.state;
+    record.frame.offset = out_index;
+    record.frame.len    = p_worker->in_end - out_index;
+    record.frame.status = STX_ETX_Decode(&p_worker->instance,
+                                         &p_worker->p_in[in_index],
+                                         &record.in_len,
+                                         &p_worker->p_out[out_index],
+                                         &record.frame.len);
+
+    if (STX_ETX_IsError(record.frame.status))
+    {
+      record.frame.len = 0;
+    }
+
+    if (!STX_ETX_WorkerAppend(p_worker, &record))
+    {
+      p_worker->records_cnt = 0;
+      break;
+    }
+
+    in_index  += record.in_len;
+    out_index += record.frame.len;
+  }
+  return NULL;
+}
+
+static bool STX_ETX_WorkerAppend(STX_ETX_Worker_t * p_worker, STX_ETX_Record_t const * p_record)
+{
+  if (p_worker->records_cnt == p_worker->records_size)
+  {
+    size_t             records_size = (0 != p_worker->records_size) ? (2 * p_worker->records_size) : 1024;
+    STX_ETX_Record_t * p_records    = realloc(p_worker->p_records, records_size * sizeof(STX_ETX_Record_t));
+
+    if (NULL == p_records)
+    {
+      return false;
+    }
+
+    p_worker->p_records    = p_records;
+    p_worker->records_size = records_size;
+  }
+
+  p_worker->p_records[p_worker->records_cnt++] = *p_record;
+  return true;
+}
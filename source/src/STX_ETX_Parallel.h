@@ -0,0 +1,72 @@
+#ifndef STX_ETX_PARALLEL_H
+#define STX_ETX_PARALLEL_H
+
+/**
+ *  @file STX_ETX_Parallel.h
+ *  @brief Header file for STX-ETX Parser parallel decoder
+ *
+ *         This file contains API of STX-ETX Parser parallel decoder, which
+ *         decodes large buffers with multiple threads.
+ *
+ *  @author Wojciech Jasko
+ */
+
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "STX_ETX.h"
+
+/********************************************
+ * EXPORTED #define CONSTANTS AND MACROS    *
+ ********************************************/
+
+#ifndef STX_ETX_PARALLEL_MIN_CHUNK_LEN
+#define STX_ETX_PARALLEL_MIN_CHUNK_LEN  (64 * 1024)  /** Minimal number of input bytes decoded by one thread. */
+#endif
+
+/********************************************
+ * EXPORTED FUNCTIONS PROTOTYPES            *
+ ********************************************/
+
+/** @brief Decode multiple STX-ETX frames with multiple threads.
+ *
+ *  @note Input is split at STX characters and the chunks are decoded
+ *        speculatively by separate threads. The chunks are then stitched in
+ *        order, decoding serially wherever a split turns out to be inside of
+ *        a frame. The results are identical to STX_ETX_DecodeBatch.
+ *
+ *  @note Input and output buffers must not overlap. If output buffer is
+ *        shorter than input buffer, STX_ETX_DecodeBatch is used.
+ *
+ *  @note With STX_ETX_STATS only frames decoded serially are counted in
+ *        statistics of the parser instance.
+ *
+ *  @param [in]      p_instance  Pointer to parser instance.
+ *  @param [in]      p_in        Pointer to input buffer.
+ *  @param [in,out]  p_in_len    in:  Input buffer length.
+ *                               out: Number of bytes read from input buffer.
+ *  @param [out]     p_out       Pointer to output buffer.
+ *  @param [in,out]  p_out_len   in:  Output buffer length.
+ *                               out: Number of bytes written to output buffer.
+ *  @param [out]     p_frames    Pointer to frame descriptors.
+ *  @param [in,out]  p_frames_cnt in:  Number of frame descriptors.
+ *                               out: Number of frame descriptors written.
+ *  @param [in]      threads_cnt Maximal number of threads, 0 for number of online CPUs.
+ *
+ *  @return STX_ETX_Status_t Status of last frame or OVERFLOW.
+ */
+STX_ETX_Status_t STX_ETX_DecodeParallel(STX_ETX_t *       p_instance,
+                                       uint8_t const *   p_in,
+                                       size_t *          p_in_len,
+                                       uint8_t *         p_out,
+                                       size_t *          p_out_len,
+                                       STX_ETX_Frame_t * p_frames,
+                                       size_t *          p_frames_cnt,
+                                       size_t            threads_cnt);
+
+#endif /* #ifndef STX_ETX_PARALLEL_H */
@@ -0,0 +1,295 @@
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <string.h>
+
+#include "STX_ETX_Pool.h"
+#include "STX_ETX_Alloc.h"
+
+/********************************************
+ * LOCAL #define CONSTANTS AND MACROS       *
+ ********************************************/
+
+#define STX_ETX_POOL_EMPTY  UINT32_MAX  /** Index of empty free list. */
+
+/** @brief Get frame header from its payload. */
+#define STX_ETX_POOL_FRAME_OF(p_data) \
+  ((STX_ETX_PoolFrame_t *)((p_data) - STX_ETX_POOL_CACHE_LINE))
+
+/********************************************
+ * LOCAL FUNCTIONS PROTOTYPES               *
+ ********************************************/
+
+/** @brief Get frame of size class by slot index.
+ *
+ *  @param [in]      p_class    Pointer to size class.
+ *  @param [in]      index      Slot index.
+ *
+ *  @return STX_ETX_PoolFrame_t * Pointer to frame.
+ */
+static STX_ETX_PoolFrame_t * STX_ETX_Pool_Slot(STX_ETX_PoolClass_t const * p_class, uint32_t index);
+
+
+/** @brief Pop frame from free list of size class.
+ *
+ *  @param [in,out]  p_class    Pointer to size class.
+ *
+ *  @return STX_ETX_PoolFrame_t * Pointer to frame, NULL if free list is empty.
+ */
+static STX_ETX_PoolFrame_t * STX_ETX_Pool_Pop(STX_ETX_PoolClass_t * p_class);
+
+
+/** @brief Push frame to free list of its size class.
+ *
+ *  @param [in,out]  p_frame    Pointer to frame.
+ *
+ *  @return void.
+ */
+static void STX_ETX_Pool_Push(STX_ETX_PoolFrame_t * p_frame);
+
+
+/** @brief Move frame in progress to larger size class (allocator grow callback).
+ *
+ *  @param [in]      p_context  Pointer to pool.
+ *  @param [in]      p_data     Pointer to payload of frame, NULL if not started yet.
+ *  @param [in]      len        Number of bytes used.
+ *  @param [in]      min_len    Requested capacity.
+ *  @param [out]     p_capacity Capacity of new frame.
+ *
+ *  @return uint8_t * Pointer to payload of new frame, NULL if no slot is free.
+ */
+static uint8_t * STX_ETX_Pool_Grow(void *    p_context,
+                                   uint8_t * p_data,
+                                   size_t    len,
+                                   size_t    min_len,
+                                   size_t *  p_capacity);
+
+/********************************************
+ * EXPORTED FUNCTION DEFINITIONS            *
+ ********************************************/
+
+bool STX_ETX_Pool_Init(STX_ETX_Pool_t *                  p_pool,
+                       void *                            p_storage,
+                       size_t                            storage_size,
+                       STX_ETX_PoolClassConfig_t const * p_classes,
+                       size_t                            classes_cnt)
+{
+  if ((classes_cnt > STX_ETX_POOL_CLASSES_MAX) ||
+      (0 != ((uintptr_t)p_storage % STX_ETX_POOL_CACHE_LINE)) ||
+      (storage_size < STX_ETX_Pool_StorageSize(p_classes, classes_cnt)))
+  {
+    return false;
+  }
+
+  uint8_t * p_slots = (uint8_t *)p_storage;
+
+  memset(p_pool, 0, sizeof(*p_pool));
+  p_pool->classes_cnt = classes_cnt;
+
+  for (size_t class_index = 0; class_index < classes_cnt; class_index++)
+  {
+    STX_ETX_PoolClass_t * p_class = &p_pool->classes[class_index];
+
+    if ((p_classes[class_index].slots_cnt >= STX_ETX_POOL_EMPTY) ||
+        ((0 != class_index) && (p_classes[class_index].slot_size < p_classes[class_index - 1].slot_size)))
+    {
+      return false;
+    }
+
+    p_class->p_slots   = p_slots;
+    p_class->stride    = STX_ETX_POOL_SLOT_STRIDE(p_classes[class_index].slot_size);
+    p_class->slot_size = p_classes[class_index].slot_size;
+    p_class->free_head = STX_ETX_POOL_EMPTY;
+
+    for (size_t index = 0; index < p_classes[class_index].slots_cnt; index++)
+    {
+      STX_ETX_PoolFrame_t * p_frame = STX_ETX_Pool_Slot(p_class, (uint32_t)index);
+
+      p_frame->p_data   = (uint8_t *)p_frame + STX_ETX_POOL_CACHE_LINE;
+      p_frame->len      = 0;
+      p_frame->capacity = p_class->slot_size;
+      p_frame->p_class  = p_class;
+      p_frame->refs_cnt = 0;
+      p_frame->next     = (index + 1 < p_classes[class_index].slots_cnt) ? (uint32_t)(index + 1) : STX_ETX_POOL_EMPTY;
+    }
+
+    if (0 != p_classes[class_index].slots_cnt)
+    {
+      p_class->free_head = 0;
+    }
+    p_slots += STX_ETX_POOL_CLASS_STORAGE_SIZE(p_classes[class_index].slots_cnt, p_classes[class_index].slot_size);
+  }
+  return true;
+}
+
+size_t STX_ETX_Pool_StorageSize(STX_ETX_PoolClassConfig_t const * p_classes, size_t classes_cnt)
+{
+  size_t storage_size = 0;
+
+  for (size_t class_index = 0; class_index < classes_cnt; class_index++)
+  {
+    storage_size += STX_ETX_POOL_CLASS_STORAGE_SIZE(p_classes[class_index].slots_cnt, p_classes[class_index].slot_size);
+  }
+  return storage_size;
+}
+
+STX_ETX_PoolFrame_t * STX_ETX_Pool_Alloc(STX_ETX_Pool_t * p_pool, size_t capacity)
+{
+  for (size_t class_index = 0; class_index < p_pool->classes_cnt; class_index++)
+  {
+    STX_ETX_PoolClass_t * p_class = &p_pool->classes[class_index];
+
+    if (p_class->slot_size >= capacity)
+    {
+      STX_ETX_PoolFrame_t * p_frame = STX_ETX_Pool_Pop(p_class);
+
+      if (NULL != p_frame)
+      {
+        p_frame->len = 0;
+        __atomic_store_n(&p_frame->refs_cnt, 1, __ATOMIC_RELAXED);
+        return p_frame;
+      }
+    }
+  }
+  return NULL;
+}
+
+void STX_ETX_Pool_Retain(STX_ETX_PoolFrame_t * p_frame)
+{
+  __atomic_fetch_add(&p_frame->refs_cnt, 1, __ATOMIC_RELAXED);
+}
+
+void STX_ETX_Pool_Release(STX_ETX_PoolFrame_t * p_frame)
+{
+  /* Last reference sees writes of all previous holders before the slot is reused. */
+  if (1 == __atomic_fetch_sub(&p_frame->refs_cnt, 1, __ATOMIC_ACQ_REL))
+  {
+    STX_ETX_Pool_Push(p_frame);
+  }
+}
+
+STX_ETX_Status_t STX_ETX_DecodeToPool(STX_ETX_t *            p_instance,
+                                      uint8_t const *        p_in,
+                                      size_t *               p_in_len,
+                                      STX_ETX_Pool_t *       p_pool,
+                                      STX_ETX_PoolFrame_t ** pp_frame)
+{
+  STX_ETX_Allocator_t   allocator = {STX_ETX_Pool_Grow, NULL, p_pool};
+  STX_ETX_PoolFrame_t * p_frame   = *pp_frame;
+  STX_ETX_Buffer_t      buffer    = {NULL, 0, 0};
+
+  if (NULL != p_frame)
+  {
+    buffer.p_data   = p_frame->p_data;
+    buffer.len      = p_frame->len;
+    buffer.capacity = p_frame->capacity;
+  }
+
+  STX_ETX_Status_t status = STX_ETX_DecodeAlloc(p_instance, p_in, p_in_len, &buffer, &allocator);
+
+  p_frame = (NULL != buffer.p_data) ? STX_ETX_POOL_FRAME_OF(buffer.p_data) : NULL;
+
+  if (NULL != p_frame)
+  {
+    p_frame->len = buffer.len;
+
+    if (STX_ETX_IsError(status))
+    {
+      STX_ETX_Pool_Release(p_frame);
+      p_frame = NULL;
+    }
+  }
+
+  *pp_frame = p_frame;
+  return status;
+}
+
+/********************************************
+ * LOCAL FUNCTION DEFINITIONS               *
+ ********************************************/
+
+static STX_ETX_PoolFrame_t * STX_ETX_Pool_Slot(STX_ETX_PoolClass_t const * p_class, uint32_t index)
+{
+  return (STX_ETX_PoolFrame_t *)&p_class->p_slots[index * p_class->stride];
+}
+
+static STX_ETX_PoolFrame_t * STX_ETX_Pool_Pop(STX_ETX_PoolClass_t * p_class)
+{
+  uint64_t head = __atomic_load_n(&p_class->free_head, __ATOMIC_ACQUIRE);
+  uint64_t new_head;
+  uint32_t index;
+
+  /* Tag is incremented by every change, so head popped and pushed back in
+   * the meantime (ABA) fails the exchange. */
+  do
+  {
+    index = (uint32_t)head;
+
+    if (STX_ETX_POOL_EMPTY == index)
+    {
+      return NULL;
+    }
+
+    uint32_t next = __atomic_load_n(&STX_ETX_Pool_Slot(p_class, index)->next, __ATOMIC_RELAXED);
+
+    new_head = (((head >> 32) + 1) << 32) | next;
+  }
+  while (!__atomic_compare_exchange_n(&p_class->free_head, &head, new_head, true, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+
+  return STX_ETX_Pool_Slot(p_class, index);
+}
+
+static void STX_ETX_Pool_Push(STX_ETX_PoolFrame_t * p_frame)
+{
+  STX_ETX_PoolClass_t * p_class = p_frame->p_class;
+  uint32_t              index   = (uint32_t)(((uint8_t *)p_frame - p_class->p_slots) / p_class->stride);
+  uint64_t              head    = __atomic_load_n(&p_class->free_head, __ATOMIC_RELAXED);
+  uint64_t              new_head;
+
+  do
+  {
+    __atomic_store_n(&p_frame->next, (uint32_t)head, __ATOMIC_RELAXED);
+    new_head = (((head >> 32) + 1) << 32) | index;
+  }
+  while (!__atomic_compare_exchange_n(&p_class->free_head, &head, new_head, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+static uint8_t * STX_ETX_Pool_Grow(void *    p_context,
+                                   uint8_t * p_data,
+                                   size_t    len,
+                                   size_t    min_len,
+                                   size_t *  p_capacity)
+{
+  STX_ETX_Pool_t *      p_pool  = (STX_ETX_Pool_t *)p_context;
+  STX_ETX_PoolFrame_t * p_frame = NULL;
+
+  /* New frame starts in the smallest class, full one skips classes below requested capacity. */
+  if (NULL == p_data)
+  {
+    p_frame = STX_ETX_Pool_Alloc(p_pool, 1);
+  }
+  else
+  {
+    p_frame = STX_ETX_Pool_Alloc(p_pool, min_len);
+
+    if (NULL == p_frame)
+    {
+      p_frame = STX_ETX_Pool_Alloc(p_pool, len + 1);
+    }
+  }
+
+  if (NULL == p_frame)
+  {
+    return NULL;
+  }
+
+  if (NULL != p_data)
+  {
+    memcpy(p_frame->p_data, p_data, len);
+    STX_ETX_Pool_Release(STX_ETX_POOL_FRAME_OF(p_data));
+  }
+
+  *p_capacity = p_frame->capacity;
+  return p_frame->p_data;
+}
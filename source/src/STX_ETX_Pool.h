@@ -0,0 +1,177 @@
+#ifndef STX_ETX_POOL_H
+#define STX_ETX_POOL_H
+
+/**
+ *  @file STX_ETX_Pool.h
+ *  @brief Header file for STX-ETX Parser frame pool
+ *
+ *         This file contains API of frame pool with fixed size classes of
+ *         slots carved from user storage. Payloads are aligned to cache
+ *         line. Frames are reference counted, so one decoded frame may be
+ *         passed to several consumers and it returns to its lock-free free
+ *         list, when the last one releases it.
+ *
+ *  @author Wojciech Jasko
+ */
+
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "STX_ETX.h"
+
+/********************************************
+ * EXPORTED #define CONSTANTS AND MACROS    *
+ ********************************************/
+
+#define STX_ETX_POOL_CACHE_LINE   64  /** Cache line size, payloads and storage are aligned to. */
+#define STX_ETX_POOL_CLASSES_MAX  8   /** Maximal number of size classes. */
+
+/** @brief Distance between slots of size class (frame header and payload). */
+#define STX_ETX_POOL_SLOT_STRIDE(slot_size) \
+  (STX_ETX_POOL_CACHE_LINE + (((slot_size) + STX_ETX_POOL_CACHE_LINE - 1) & ~(size_t)(STX_ETX_POOL_CACHE_LINE - 1)))
+
+/** @brief Size of storage required by size class (pool storage is sum of its classes). */
+#define STX_ETX_POOL_CLASS_STORAGE_SIZE(slots_cnt, slot_size) \
+  ((slots_cnt) * STX_ETX_POOL_SLOT_STRIDE(slot_size))
+
+/********************************************
+ * EXPORTED TYPES DEFINITIONS               *
+ ********************************************/
+
+/** @brief STX ETX Pool size class configuration. */
+typedef struct
+{
+  size_t                         slot_size;       //!< Payload capacity of slot.
+  size_t                         slots_cnt;       //!< Number of slots.
+} STX_ETX_PoolClassConfig_t;
+
+
+/** @brief STX ETX Pool size class. */
+typedef struct
+{
+  uint8_t *                      p_slots;         //!< Pointer to first slot.
+  size_t                         stride;          //!< Distance between slots.
+  size_t                         slot_size;       //!< Payload capacity of slot.
+
+  /** Shared by producers and consumers. */
+  uint64_t                       free_head __attribute__((aligned(STX_ETX_POOL_CACHE_LINE))); //!< Tag (high half) and index of first free slot.
+} STX_ETX_PoolClass_t;
+
+
+/** @brief STX ETX Frame pool. */
+typedef struct
+{
+  STX_ETX_PoolClass_t            classes[STX_ETX_POOL_CLASSES_MAX]; //!< Size classes sorted by slot size.
+  size_t                         classes_cnt;     //!< Number of size classes.
+} STX_ETX_Pool_t;
+
+
+/** @brief STX ETX Pool frame (header of slot, payload follows in next cache line). */
+typedef struct
+{
+  uint8_t *                      p_data;          //!< Pointer to payload.
+  size_t                         len;             //!< Payload length.
+  size_t                         capacity;        //!< Payload capacity.
+  STX_ETX_PoolClass_t *          p_class;         //!< Size class, frame belongs to.
+  uint32_t                       refs_cnt;        //!< Number of references.
+  uint32_t                       next;            //!< Index of next free slot.
+} STX_ETX_PoolFrame_t;
+
+/********************************************
+ * EXPORTED FUNCTIONS PROTOTYPES            *
+ ********************************************/
+
+/** @brief Initialize frame pool.
+ *
+ *  @note Storage is split into size classes in order of configurations.
+ *
+ *  @param [out]     p_pool       Pointer to pool.
+ *  @param [in]      p_storage    Pointer to storage aligned to STX_ETX_POOL_CACHE_LINE.
+ *  @param [in]      storage_size Storage size.
+ *  @param [in]      p_classes    Pointer to size class configurations sorted by slot size.
+ *  @param [in]      classes_cnt  Number of size classes (up to STX_ETX_POOL_CLASSES_MAX).
+ *
+ *  @return bool  True, if succeeded.
+ */
+bool STX_ETX_Pool_Init(STX_ETX_Pool_t *                  p_pool,
+                       void *                            p_storage,
+                       size_t                            storage_size,
+                       STX_ETX_PoolClassConfig_t const * p_classes,
+                       size_t                            classes_cnt);
+
+
+/** @brief Get size of storage required by frame pool.
+ *
+ *  @param [in]      p_classes    Pointer to size class configurations.
+ *  @param [in]      classes_cnt  Number of size classes.
+ *
+ *  @return size_t Storage size.
+ */
+size_t STX_ETX_Pool_StorageSize(STX_ETX_PoolClassConfig_t const * p_classes, size_t classes_cnt);
+
+
+/** @brief Take frame from pool.
+ *
+ *  @note Frame is taken from the smallest class with enough capacity and
+ *        free slot. Thread safe. Frame has single reference and length 0.
+ *
+ *  @param [in,out]  p_pool     Pointer to pool.
+ *  @param [in]      capacity   Required payload capacity.
+ *
+ *  @return STX_ETX_PoolFrame_t * Pointer to frame, NULL if no slot is free.
+ */
+STX_ETX_PoolFrame_t * STX_ETX_Pool_Alloc(STX_ETX_Pool_t * p_pool, size_t capacity);
+
+
+/** @brief Add reference to frame.
+ *
+ *  @note Thread safe. Caller must already hold a reference.
+ *
+ *  @param [in,out]  p_frame    Pointer to frame.
+ *
+ *  @return void.
+ */
+void STX_ETX_Pool_Retain(STX_ETX_PoolFrame_t * p_frame);
+
+
+/** @brief Drop reference to frame.
+ *
+ *  @note Thread safe. Frame returns to pool with the last reference.
+ *
+ *  @param [in,out]  p_frame    Pointer to frame.
+ *
+ *  @return void.
+ */
+void STX_ETX_Pool_Release(STX_ETX_PoolFrame_t * p_frame);
+
+
+/** @brief Decode STX-ETX data into frame taken from pool.
+ *
+ *  @note Works as STX_ETX_DecodeAlloc. Frame in progress starts in the
+ *        smallest class and is moved to larger class, when it is full.
+ *        Pass NULL frame to start. On CONTINUE and OVERFLOW (no slot is
+ *        free) frame in progress is returned, pass it to the next call.
+ *        On DONE caller owns returned frame. On error frame is released
+ *        and NULL is returned.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in]      p_in       Pointer to input buffer.
+ *  @param [in,out]  p_in_len   in:  Input buffer length.
+ *                              out: Number of bytes read from input buffer.
+ *  @param [in,out]  p_pool     Pointer to pool.
+ *  @param [in,out]  pp_frame   Pointer to frame in progress.
+ *
+ *  @return STX_ETX_Status_t.
+ */
+STX_ETX_Status_t STX_ETX_DecodeToPool(STX_ETX_t *            p_instance,
+                                      uint8_t const *        p_in,
+                                      size_t *               p_in_len,
+                                      STX_ETX_Pool_t *       p_pool,
+                                      STX_ETX_PoolFrame_t ** pp_frame);
+
+#endif /* #ifndef STX_ETX_POOL_H */
@@ -0,0 +1,239 @@
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <string.h>
+
+#include "STX_ETX_Ring.h"
+
+/********************************************
+ * LOCAL #define CONSTANTS AND MACROS       *
+ ********************************************/
+
+/** @brief Check if value is power of two. */
+#define STX_ETX_IS_POWER_OF_TWO(value) ((0 != (value)) && (0 == ((value) & ((value) - 1))))
+
+/********************************************
+ * EXPORTED FUNCTION DEFINITIONS            *
+ ********************************************/
+
+bool STX_ETX_ByteRing_Init(STX_ETX_ByteRing_t * p_ring, uint8_t * p_buf, size_t size)
+{
+  if (!STX_ETX_IS_POWER_OF_TWO(size))
+  {
+    return false;
+  }
+
+  memset(p_ring, 0, sizeof(*p_ring));
+  p_ring->p_buf = p_buf;
+  p_ring->mask  = size - 1;
+  return true;
+}
+
+size_t STX_ETX_ByteRing_Acquire(STX_ETX_ByteRing_t * p_ring, uint8_t ** pp_data)
+{
+  size_t head = p_ring->head;
+  size_t size = p_ring->mask + 1;
+
+  if (head - p_ring->tail_cache == size)
+  {
+    p_ring->tail_cache = __atomic_load_n(&p_ring->tail, __ATOMIC_ACQUIRE);
+  }
+
+  size_t index    = head & p_ring->mask;
+  size_t free_len = size - (head - p_ring->tail_cache);
+
+  *pp_data = &p_ring->p_buf[index];
+  return (free_len < size - index) ? free_len : (size - index);
+}
+
+void STX_ETX_ByteRing_Commit(STX_ETX_ByteRing_t * p_ring, size_t len)
+{
+  __atomic_store_n(&p_ring->head, p_ring->head + len, __ATOMIC_RELEASE);
+}
+
+size_t STX_ETX_ByteRing_Write(STX_ETX_ByteRing_t * p_ring, uint8_t const * p_data, size_t len)
+{
+  size_t written_len = 0;
+
+  while (written_len < len)
+  {
+    uint8_t * p_free;
+    size_t    free_len = STX_ETX_ByteRing_Acquire(p_ring, &p_free);
+
+    if (0 == free_len)
+    {
+      break;
+    }
+
+    if (free_len > len - written_len)
+    {
+      free_len = len - written_len;
+    }
+
+    memcpy(p_free, &p_data[written_len], free_len);
+    STX_ETX_ByteRing_Commit(p_ring, free_len);
+    written_len += free_len;
+  }
+  return written_len;
+}
+
+size_t STX_ETX_ByteRing_Peek(STX_ETX_ByteRing_t * p_ring, uint8_t const ** pp_data)
+{
+  size_t tail = p_ring->tail;
+  size_t size = p_ring->mask + 1;
+
+  if (p_ring->head_cache == tail)
+  {
+    p_ring->head_cache = __atomic_load_n(&p_ring->head, __ATOMIC_ACQUIRE);
+  }
+
+  size_t index    = tail & p_ring->mask;
+  size_t data_len = p_ring->head_cache - tail;
+
+  *pp_data = &p_ring->p_buf[index];
+  return (data_len < size - index) ? data_len : (size - index);
+}
+
+void STX_ETX_ByteRing_Release(STX_ETX_ByteRing_t * p_ring, size_t len)
+{
+  __atomic_store_n(&p_ring->tail, p_ring->tail + len, __ATOMIC_RELEASE);
+}
+
+STX_ETX_Status_t STX_ETX_ByteRing_Decode(STX_ETX_t *          p_instance,
+                                         STX_ETX_ByteRing_t * p_ring,
+                                         uint8_t *            p_out,
+                                         size_t *             p_out_len)
+{
+  STX_ETX_Status_t status    = STX_ETX_STATUS_CONTINUE;
+  size_t           out_index = 0;
+
+  while (STX_ETX_STATUS_CONTINUE == status)
+  {
+    uint8_t const * p_data;
+    size_t          in_len  = STX_ETX_ByteRing_Peek(p_ring, &p_data);
+    size_t          out_len = *p_out_len - out_index;
+
+    if (0 == in_len)
+    {
+      break;
+    }
+
+    status = STX_ETX_Decode(p_instance, p_data, &in_len, &p_out[out_index], &out_len);
+
+    STX_ETX_ByteRing_Release(p_ring, in_len);
+    out_index += out_len;
+  }
+
+  *p_out_len = out_index;
+  return status;
+}
+
+bool STX_ETX_FrameRing_Init(STX_ETX_FrameRing_t * p_ring, void * p_storage, size_t slots_cnt, size_t slot_size)
+{
+  if (!STX_ETX_IS_POWER_OF_TWO(slots_cnt))
+  {
+    return false;
+  }
+
+  memset(p_ring, 0, sizeof(*p_ring));
+  p_ring->p_lens    = (size_t *)p_storage;
+  p_ring->p_slots   = (uint8_t *)&p_ring->p_lens[slots_cnt];
+  p_ring->slot_size = slot_size;
+  p_ring->mask      = slots_cnt - 1;
+  return true;
+}
+
+uint8_t * STX_ETX_FrameRing_Acquire(STX_ETX_FrameRing_t * p_ring)
+{
+  size_t head = p_ring->head;
+
+  if (head - p_ring->tail_cache > p_ring->mask)
+  {
+    p_ring->tail_cache = __atomic_load_n(&p_ring->tail, __ATOMIC_ACQUIRE);
+
+    if (head - p_ring->tail_cache > p_ring->mask)
+    {
+      return NULL;
+    }
+  }
+  return &p_ring->p_slots[(head & p_ring->mask) * p_ring->slot_size];
+}
+
+void STX_ETX_FrameRing_Commit(STX_ETX_FrameRing_t * p_ring, size_t len)
+{
+  p_ring->p_lens[p_ring->head & p_ring->mask] = len;
+  __atomic_store_n(&p_ring->head, p_ring->head + 1, __ATOMIC_RELEASE);
+}
+
+uint8_t const * STX_ETX_FrameRing_Peek(STX_ETX_FrameRing_t * p_ring, size_t * p_len)
+{
+  size_t tail = p_ring->tail;
+
+  if (p_ring->head_cache == tail)
+  {
+    p_ring->head_cache = __atomic_load_n(&p_ring->head, __ATOMIC_ACQUIRE);
+
+    if (p_ring->head_cache == tail)
+    {
+      return NULL;
+    }
+  }
+
+  *p_len = p_ring->p_lens[tail & p_ring->mask];
+  return &p_ring->p_slots[(tail & p_ring->mask) * p_ring->slot_size];
+}
+
+void STX_ETX_FrameRing_Release(STX_ETX_FrameRing_t * p_ring)
+{
+  __atomic_store_n(&p_ring->tail, p_ring->tail + 1, __ATOMIC_RELEASE);
+}
+
+STX_ETX_Status_t STX_ETX_Ring_DecodeFrames(STX_ETX_t *           p_instance,
+                                           STX_ETX_ByteRing_t *  p_in,
+                                           STX_ETX_FrameRing_t * p_out)
+{
+  while (true)
+  {
+    uint8_t * p_slot = STX_ETX_FrameRing_Acquire(p_out);
+
+    if (NULL == p_slot)
+    {
+      return STX_ETX_STATUS_OVERFLOW;
+    }
+
+    uint8_t const * p_data;
+    size_t          in_len = STX_ETX_ByteRing_Peek(p_in, &p_data);
+
+    if (0 == in_len)
+    {
+      return STX_ETX_STATUS_CONTINUE;
+    }
+
+    size_t           out_len = p_out->slot_size - p_out->fill;
+    STX_ETX_Status_t status  = STX_ETX_Decode(p_instance, p_data, &in_len, &p_slot[p_out->fill], &out_len);
+
+    STX_ETX_ByteRing_Release(p_in, in_len);
+    p_out->fill += out_len;
+
+    switch (status)
+    {
+      case STX_ETX_STATUS_CONTINUE:
+        break;
+
+      case STX_ETX_STATUS_DONE:
+        STX_ETX_FrameRing_Commit(p_out, p_out->fill);
+        p_out->fill = 0;
+        break;
+
+      case STX_ETX_STATUS_OVERFLOW:
+        STX_ETX_Reset(p_instance);
+        p_out->fill = 0;
+        return status;
+
+      default:
+        p_out->fill = 0;
+        return status;
+    }
+  }
+}
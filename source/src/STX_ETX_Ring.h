@@ -0,0 +1,229 @@
+#ifndef STX_ETX_RING_H
+#define STX_ETX_RING_H
+
+/**
+ *  @file STX_ETX_Ring.h
+ *  @brief Header file for STX-ETX Parser rings
+ *
+ *         This file contains API of lock-free single-producer single-consumer
+ *         byte ring, which can be decoded in place, and frame ring for
+ *         passing decoded frames between threads.
+ *
+ *  @author Wojciech Jasko
+ */
+
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "STX_ETX.h"
+
+/********************************************
+ * EXPORTED #define CONSTANTS AND MACROS    *
+ ********************************************/
+
+#define STX_ETX_RING_CACHE_LINE  64  /** Cache line size, producer and consumer indexes are separated by. */
+
+/** @brief Size of storage required by frame ring. */
+#define STX_ETX_FRAME_RING_STORAGE_SIZE(slots_cnt, slot_size) \
+  ((slots_cnt) * (sizeof(size_t) + (slot_size)))
+
+/********************************************
+ * EXPORTED TYPES DEFINITIONS               *
+ ********************************************/
+
+/** @brief STX ETX Byte ring. */
+typedef struct
+{
+  uint8_t *                      p_buf;           //!< Pointer to buffer.
+  size_t                         mask;            //!< Buffer size - 1.
+
+  /** Producer. */
+  size_t                         head __attribute__((aligned(STX_ETX_RING_CACHE_LINE))); //!< Number of bytes written.
+  size_t                         tail_cache;      //!< Last tail seen by producer.
+
+  /** Consumer. */
+  size_t                         tail __attribute__((aligned(STX_ETX_RING_CACHE_LINE))); //!< Number of bytes read.
+  size_t                         head_cache;      //!< Last head seen by consumer.
+} STX_ETX_ByteRing_t;
+
+
+/** @brief STX ETX Frame ring. */
+typedef struct
+{
+  size_t *                       p_lens;          //!< Pointer to frame lengths.
+  uint8_t *                      p_slots;         //!< Pointer to frame slots.
+  size_t                         slot_size;       //!< Slot size.
+  size_t                         mask;            //!< Number of slots - 1.
+
+  /** Producer. */
+  size_t                         head __attribute__((aligned(STX_ETX_RING_CACHE_LINE))); //!< Number of frames written.
+  size_t                         tail_cache;      //!< Last tail seen by producer.
+  size_t                         fill;            //!< Number of bytes in slot being written.
+
+  /** Consumer. */
+  size_t                         tail __attribute__((aligned(STX_ETX_RING_CACHE_LINE))); //!< Number of frames read.
+  size_t                         head_cache;      //!< Last head seen by consumer.
+} STX_ETX_FrameRing_t;
+
+/********************************************
+ * EXPORTED FUNCTIONS PROTOTYPES            *
+ ********************************************/
+
+/** @brief Initialize byte ring.
+ *
+ *  @param [out]     p_ring     Pointer to ring.
+ *  @param [in]      p_buf      Pointer to buffer.
+ *  @param [in]      size       Buffer size, power of two.
+ *
+ *  @return bool  True, if size is power of two.
+ */
+bool STX_ETX_ByteRing_Init(STX_ETX_ByteRing_t * p_ring, uint8_t * p_buf, size_t size);
+
+
+/** @brief Get contiguous free space of byte ring (producer).
+ *
+ *  @param [in,out]  p_ring     Pointer to ring.
+ *  @param [out]     pp_data    Pointer to free space.
+ *
+ *  @return size_t Length of free space.
+ */
+size_t STX_ETX_ByteRing_Acquire(STX_ETX_ByteRing_t * p_ring, uint8_t ** pp_data);
+
+
+/** @brief Publish bytes written to free space of byte ring (producer).
+ *
+ *  @param [in,out]  p_ring     Pointer to ring.
+ *  @param [in]      len        Number of bytes written.
+ *
+ *  @return void.
+ */
+void STX_ETX_ByteRing_Commit(STX_ETX_ByteRing_t * p_ring, size_t len);
+
+
+/** @brief Copy bytes to byte ring (producer).
+ *
+ *  @param [in,out]  p_ring     Pointer to ring.
+ *  @param [in]      p_data     Pointer to data.
+ *  @param [in]      len        Data length.
+ *
+ *  @return size_t Number of bytes copied.
+ */
+size_t STX_ETX_ByteRing_Write(STX_ETX_ByteRing_t * p_ring, uint8_t const * p_data, size_t len);
+
+
+/** @brief Get contiguous data of byte ring (consumer).
+ *
+ *  @param [in,out]  p_ring     Pointer to ring.
+ *  @param [out]     pp_data    Pointer to data.
+ *
+ *  @return size_t Data length.
+ */
+size_t STX_ETX_ByteRing_Peek(STX_ETX_ByteRing_t * p_ring, uint8_t const ** pp_data);
+
+
+/** @brief Free bytes read from byte ring (consumer).
+ *
+ *  @param [in,out]  p_ring     Pointer to ring.
+ *  @param [in]      len        Number of bytes read.
+ *
+ *  @return void.
+ */
+void STX_ETX_ByteRing_Release(STX_ETX_ByteRing_t * p_ring, size_t len);
+
+
+/** @brief Decode STX-ETX data from byte ring in place (consumer).
+ *
+ *  @note Works as STX_ETX_Decode with the ring data as input, including
+ *        data wrapped around the end of buffer. Bytes read are freed.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in,out]  p_ring     Pointer to ring.
+ *  @param [out]     p_out      Pointer to output buffer.
+ *  @param [in,out]  p_out_len  in:  Output buffer length.
+ *                              out: Number of bytes written to output buffer.
+ *
+ *  @return STX_ETX_Status_t Conversion status.
+ */
+STX_ETX_Status_t STX_ETX_ByteRing_Decode(STX_ETX_t *          p_instance,
+                                         STX_ETX_ByteRing_t * p_ring,
+                                         uint8_t *            p_out,
+                                         size_t *             p_out_len);
+
+
+/** @brief Initialize frame ring.
+ *
+ *  @param [out]     p_ring     Pointer to ring.
+ *  @param [in]      p_storage  Pointer to storage of STX_ETX_FRAME_RING_STORAGE_SIZE(slots_cnt, slot_size)
+ *                              bytes (aligned to size_t).
+ *  @param [in]      slots_cnt  Number of slots, power of two.
+ *  @param [in]      slot_size  Slot size (maximal frame length).
+ *
+ *  @return bool  True, if slots_cnt is power of two.
+ */
+bool STX_ETX_FrameRing_Init(STX_ETX_FrameRing_t * p_ring, void * p_storage, size_t slots_cnt, size_t slot_size);
+
+
+/** @brief Get free slot of frame ring (producer).
+ *
+ *  @param [in,out]  p_ring     Pointer to ring.
+ *
+ *  @return uint8_t * Pointer to slot of slot_size bytes, NULL if ring is full.
+ */
+uint8_t * STX_ETX_FrameRing_Acquire(STX_ETX_FrameRing_t * p_ring);
+
+
+/** @brief Publish frame written to slot of frame ring (producer).
+ *
+ *  @param [in,out]  p_ring     Pointer to ring.
+ *  @param [in]      len        Frame length.
+ *
+ *  @return void.
+ */
+void STX_ETX_FrameRing_Commit(STX_ETX_FrameRing_t * p_ring, size_t len);
+
+
+/** @brief Get oldest frame of frame ring (consumer).
+ *
+ *  @param [in,out]  p_ring     Pointer to ring.
+ *  @param [out]     p_len      Frame length.
+ *
+ *  @return uint8_t const * Pointer to frame, NULL if ring is empty.
+ */
+uint8_t const * STX_ETX_FrameRing_Peek(STX_ETX_FrameRing_t * p_ring, size_t * p_len);
+
+
+/** @brief Free oldest frame of frame ring (consumer).
+ *
+ *  @param [in,out]  p_ring     Pointer to ring.
+ *
+ *  @return void.
+ */
+void STX_ETX_FrameRing_Release(STX_ETX_FrameRing_t * p_ring);
+
+
+/** @brief Decode STX-ETX frames from byte ring to frame ring.
+ *
+ *  @note Consumer of byte ring and producer of frame ring. Frames are
+ *        decoded directly into slots and published when finished.
+ *        Decoding stops, when byte ring is empty (CONTINUE), frame is
+ *        invalid (error status) or frame ring is full (OVERFLOW).
+ *        Frame longer than slot is dropped and the parser instance is reset
+ *        (also OVERFLOW). Set max_frame_len of configuration to slot size to
+ *        get TOO_LONG instead and skip rest of the frame.
+ *
+ *  @param [in]      p_instance Pointer to parser instance.
+ *  @param [in,out]  p_in       Pointer to byte ring.
+ *  @param [in,out]  p_out      Pointer to frame ring.
+ *
+ *  @return STX_ETX_Status_t CONTINUE, OVERFLOW or error status.
+ */
+STX_ETX_Status_t STX_ETX_Ring_DecodeFrames(STX_ETX_t *           p_instance,
+                                           STX_ETX_ByteRing_t *  p_in,
+                                           STX_ETX_FrameRing_t * p_out);
+
+#endif /* #ifndef STX_ETX_RING_H */
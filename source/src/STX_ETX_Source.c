@@ -0,0 +1,89 @@
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <string.h>
+
+#include "STX_ETX_Source.h"
+
+/********************************************
+ * LOCAL FUNCTIONS PROTOTYPES               *
+ ********************************************/
+
+/** @brief Get number of frames dropped by source.
+ *
+ *  @param [in]      p_source   Pointer to source.
+ *
+ *  @return size_t Number of dropped frames.
+ */
+static size_t STX_ETX_Source_DroppedCnt(STX_ETX_Source_t const * p_source);
+
+/********************************************
+ * EXPORTED FUNCTION DEFINITIONS            *
+ ********************************************/
+
+void STX_ETX_Source_Init(STX_ETX_Source_t *       p_source,
+                         STX_ETX_Config_t const * p_config,
+                         uint8_t *                p_frame,
+                         size_t                   frame_size)
+{
+  memset(p_source, 0, sizeof(*p_source));
+  p_source->config     = *p_config;
+  p_source->p_frame    = p_frame;
+  p_source->frame_size = frame_size;
+
+  if ((0 == p_source->config.max_frame_len) || (p_source->config.max_frame_len > frame_size))
+  {
+    p_source->config.max_frame_len = frame_size;
+  }
+  STX_ETX_Init(&p_source->instance, &p_source->config);
+}
+
+STX_ETX_Status_t STX_ETX_Source_Decode(STX_ETX_Source_t * p_source, uint8_t const * p_in, size_t * p_in_len)
+{
+  STX_ETX_Status_t status   = STX_ETX_STATUS_CONTINUE;
+  size_t           in_index = 0;
+
+  /* Frame finished by previous call was taken by caller. */
+  if ((STX_ETX_STATE_IDLE == p_source->instance.state) || (STX_ETX_STATE_DISCARD == p_source->instance.state))
+  {
+    p_source->frame_len = 0;
+  }
+
+  while ((in_index < *p_in_len) && (STX_ETX_STATUS_DONE != status))
+  {
+    size_t dropped_cnt = STX_ETX_Source_DroppedCnt(p_source);
+    size_t in_len      = *p_in_len - in_index;
+    size_t out_len     = p_source->frame_size - p_source->frame_len;
+
+    status = STX_ETX_DecodeResync(&p_source->instance,
+                                  &p_in[in_index],
+                                  &in_len,
+                                  &p_source->p_frame[p_source->frame_len],
+                                  &out_len,
+                                  &p_source->resync);
+
+    in_index += in_len;
+
+    /* Frame continued from previous call was dropped, new one was written after
+     * it. Frame buffer fits any frame, so overflow of new one is retried. */
+    if (dropped_cnt != STX_ETX_Source_DroppedCnt(p_source))
+    {
+      memmove(p_source->p_frame, &p_source->p_frame[p_source->frame_len], out_len);
+      p_source->frame_len = 0;
+    }
+    p_source->frame_len += out_len;
+  }
+
+  *p_in_len = in_index;
+  return (STX_ETX_STATUS_DONE == status) ? STX_ETX_STATUS_DONE : STX_ETX_STATUS_CONTINUE;
+}
+
+/********************************************
+ * LOCAL FUNCTION DEFINITIONS               *
+ ********************************************/
+
+static size_t STX_ETX_Source_DroppedCnt(STX_ETX_Source_t const * p_source)
+{
+  return p_source->resync.inv_char_cnt + p_source->resync.inv_crc_cnt + p_source->resync.too_long_cnt;
+}
@@ -0,0 +1,80 @@
+#ifndef STX_ETX_SOURCE_H
+#define STX_ETX_SOURCE_H
+
+/**
+ *  @file STX_ETX_Source.h
+ *  @brief Header file for STX-ETX Parser stream source
+ *
+ *         This file contains API of stream source, a parser instance with
+ *         its own frame buffer fed by arbitrary portions of one byte
+ *         stream (e.g. reads of file descriptor). Garbage and invalid
+ *         frames are skipped, frames longer than frame buffer are dropped.
+ *         It is shared by ingest loops (STX_ETX_Epoll, STX_ETX_Uring).
+ *
+ *  @author Wojciech Jasko
+ */
+
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "STX_ETX.h"
+
+/********************************************
+ * EXPORTED TYPES DEFINITIONS               *
+ ********************************************/
+
+/** @brief STX ETX Stream source. */
+typedef struct
+{
+  STX_ETX_t                      instance;        //!< Parser instance.
+  STX_ETX_Config_t               config;          //!< Parser configuration (frame length limited by frame buffer).
+  STX_ETX_Resync_t               resync;          //!< Resynchronization counters.
+  uint8_t *                      p_frame;         //!< Pointer to frame buffer.
+  size_t                         frame_size;      //!< Frame buffer size.
+  size_t                         frame_len;       //!< Number of bytes of frame in progress (or finished, until next decode).
+} STX_ETX_Source_t;
+
+/********************************************
+ * EXPORTED FUNCTIONS PROTOTYPES            *
+ ********************************************/
+
+/** @brief Initialize stream source.
+ *
+ *  @note Configuration is copied, its max_frame_len is limited to frame
+ *        buffer size, so longer frames are dropped (counted as too long).
+ *        Source must not be moved after initialization.
+ *
+ *  @param [out]     p_source   Pointer to source.
+ *  @param [in]      p_config   Pointer to parser configuration.
+ *  @param [in]      p_frame    Pointer to frame buffer.
+ *  @param [in]      frame_size Frame buffer size (not 0).
+ *
+ *  @return void.
+ */
+void STX_ETX_Source_Init(STX_ETX_Source_t *       p_source,
+                         STX_ETX_Config_t const * p_config,
+                         uint8_t *                p_frame,
+                         size_t                   frame_size);
+
+
+/** @brief Decode stream data until frame is finished.
+ *
+ *  @note Frame continued from previous call is completed in frame buffer.
+ *        On DONE the frame is in frame buffer (frame_len bytes) until next
+ *        call, the rest of input is decoded by next call.
+ *
+ *  @param [in,out]  p_source   Pointer to source.
+ *  @param [in]      p_in       Pointer to input buffer.
+ *  @param [in,out]  p_in_len   in:  Input buffer length.
+ *                              out: Number of bytes read from input buffer.
+ *
+ *  @return STX_ETX_Status_t DONE, if frame is finished, CONTINUE if input is consumed.
+ */
+STX_ETX_Status_t STX_ETX_Source_Decode(STX_ETX_Source_t * p_source, uint8_t const * p_in, size_t * p_in_len);
+
+#endif /* #ifndef STX_ETX_SOURCE_H */
@@ -0,0 +1,480 @@
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include "STX_ETX_Uring.h"
+
+/********************************************
+ * LOCAL #define CONSTANTS AND MACROS       *
+ ********************************************/
+
+#define STX_ETX_URING_BUF_GROUP          0    /** Group of registered read buffers. */
+#define STX_ETX_URING_PROBE_OPS_CNT      256  /** Number of probed operations. */
+#define STX_ETX_URING_OP_READ_MULTISHOT  49   /** Multishot read (kernel 6.7, missing in older headers). */
+
+/********************************************
+ * LOCAL FUNCTIONS PROTOTYPES               *
+ ********************************************/
+
+/** @brief Get free submission entry.
+ *
+ *  @note Queued entries are submitted first, if submission ring is full.
+ *
+ *  @param [in,out]  p_uring    Pointer to loop.
+ *
+ *  @return struct io_uring_sqe * Pointer to cleared entry, NULL if submission failed.
+ */
+static struct io_uring_sqe * STX_ETX_Uring_Sqe(STX_ETX_Uring_t * p_uring);
+
+
+/** @brief Queue read of source.
+ *
+ *  @param [in,out]  p_uring    Pointer to loop.
+ *  @param [in,out]  p_source   Pointer to source.
+ *
+ *  @return bool  True, if succeeded.
+ */
+static bool STX_ETX_Uring_Arm(STX_ETX_Uring_t * p_uring, STX_ETX_UringSource_t * p_source);
+
+
+/** @brief Return read buffer to the kernel (published at the end of run).
+ *
+ *  @param [in,out]  p_uring    Pointer to loop.
+ *  @param [in]      buf_id     Buffer index.
+ *
+ *  @return void.
+ */
+static void STX_ETX_Uring_PutBuf(STX_ETX_Uring_t * p_uring, uint16_t buf_id);
+
+
+/** @brief Handle completion.
+ *
+ *  @param [in,out]  p_uring    Pointer to loop.
+ *  @param [in]      p_cqe      Pointer to completion entry.
+ *
+ *  @return void.
+ */
+static void STX_ETX_Uring_Complete(STX_ETX_Uring_t * p_uring, struct io_uring_cqe const * p_cqe);
+
+
+/** @brief Decode data read from source.
+ *
+ *  @param [in,out]  p_uring    Pointer to loop.
+ *  @param [in,out]  p_source   Pointer to source.
+ *  @param [in]      p_in       Pointer to data.
+ *  @param [in]      in_len     Data length.
+ *
+ *  @return void.
+ */
+static void STX_ETX_Uring_Decode(STX_ETX_Uring_t *       p_uring,
+                                 STX_ETX_UringSource_t * p_source,
+                                 uint8_t const *         p_in,
+                                 size_t                  in_len);
+
+
+/** @brief Check, if kernel supports multishot read.
+ *
+ *  @param [in]      ring_fd    io_uring file descriptor.
+ *
+ *  @return bool  True, if supported.
+ */
+static bool STX_ETX_Uring_HasMultishot(int ring_fd);
+
+/********************************************
+ * EXPORTED FUNCTION DEFINITIONS            *
+ ********************************************/
+
+bool STX_ETX_Uring_Init(STX_ETX_Uring_t *    p_uring,
+                        uint32_t             entries,
+                        uint8_t *            p_bufs,
+                        uint32_t             buf_size,
+                        uint32_t             bufs_cnt,
+                        STX_ETX_UringFrame_t on_frame,
+                        STX_ETX_UringClose_t on_close,
+                        void *               p_context)
+{
+  struct io_uring_params params;
+
+  memset(p_uring, 0, sizeof(*p_uring));
+  memset(&params, 0, sizeof(params));
+  p_uring->ring_fd   = -1;
+  p_uring->p_bufs    = p_bufs;
+  p_uring->buf_size  = buf_size;
+  p_uring->on_frame  = on_frame;
+  p_uring->on_close  = on_close;
+  p_uring->p_context = p_context;
+
+  if ((0 == buf_size) || (0 == bufs_cnt) || (bufs_cnt > STX_ETX_URING_BUFS_MAX) || (0 != (bufs_cnt & (bufs_cnt - 1))))
+  {
+    errno = EINVAL;
+    return false;
+  }
+  p_uring->bufs_cnt = (uint16_t)bufs_cnt;
+
+  p_uring->ring_fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+
+  if (p_uring->ring_fd < 0)
+  {
+    return false;
+  }
+
+  p_uring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  p_uring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  p_uring->sqes_size    = params.sq_entries * sizeof(struct io_uring_sqe);
+
+  /* Both rings share one mapping on kernels with single mmap. */
+  if (0 != (params.features & IORING_FEAT_SINGLE_MMAP))
+  {
+    if (p_uring->cq_ring_size > p_uring->sq_ring_size)
+    {
+      p_uring->sq_ring_size = p_uring->cq_ring_size;
+    }
+    p_uring->cq_ring_size = 0;
+  }
+
+  void * p_sq_ring = mmap(NULL, p_uring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          p_uring->ring_fd, IORING_OFF_SQ_RING);
+  void * p_cq_ring = p_sq_ring;
+  void * p_sqes    = mmap(NULL, p_uring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          p_uring->ring_fd, IORING_OFF_SQES);
+
+  if (0 != p_uring->cq_ring_size)
+  {
+    p_cq_ring = mmap(NULL, p_uring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     p_uring->ring_fd, IORING_OFF_CQ_RING);
+  }
+
+  p_uring->buf_ring_size = bufs_cnt * sizeof(struct io_uring_buf);
+
+  void * p_buf_ring = mmap(NULL, p_uring->buf_ring_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+  p_uring->p_sq_ring  = (MAP_FAILED != p_sq_ring) ? p_sq_ring : NULL;
+  p_uring->p_cq_ring  = (MAP_FAILED != p_cq_ring) ? p_cq_ring : NULL;
+  p_uring->p_sqes     = (MAP_FAILED != p_sqes) ? (struct io_uring_sqe *)p_sqes : NULL;
+  p_uring->p_buf_ring = (MAP_FAILED != p_buf_ring) ? (struct io_uring_buf_ring *)p_buf_ring : NULL;
+
+  if ((NULL == p_uring->p_sq_ring) || (NULL == p_uring->p_cq_ring) || (NULL == p_uring->p_sqes) || (NULL == p_uring->p_buf_ring))
+  {
+    int error = errno;
+
+    STX_ETX_Uring_Close(p_uring);
+    errno = error;
+    return false;
+  }
+
+  uint8_t * p_sq = (uint8_t *)p_uring->p_sq_ring;
+  uint8_t * p_cq = (uint8_t *)p_uring->p_cq_ring;
+
+  p_uring->p_sq_head  = (uint32_t *)&p_sq[params.sq_off.head];
+  p_uring->p_sq_tail  = (uint32_t *)&p_sq[params.sq_off.tail];
+  p_uring->p_sq_array = (uint32_t *)&p_sq[params.sq_off.array];
+  p_uring->sq_mask    = *(uint32_t *)&p_sq[params.sq_off.ring_mask];
+  p_uring->sq_entries = params.sq_entries;
+  p_uring->p_cq_head  = (uint32_t *)&p_cq[params.cq_off.head];
+  p_uring->p_cq_tail  = (uint32_t *)&p_cq[params.cq_off.tail];
+  p_uring->cq_mask    = *(uint32_t *)&p_cq[params.cq_off.ring_mask];
+  p_uring->p_cqes     = (struct io_uring_cqe *)&p_cq[params.cq_off.cqes];
+
+  /* Read buffers are owned by the kernel, until their completions are handled. */
+  struct io_uring_buf_reg buf_reg;
+
+  memset(&buf_reg, 0, sizeof(buf_reg));
+  buf_reg.ring_addr    = (uintptr_t)p_uring->p_buf_ring;
+  buf_reg.ring_entries = bufs_cnt;
+  buf_reg.bgid         = STX_ETX_URING_BUF_GROUP;
+
+  if (syscall(__NR_io_uring_register, p_uring->ring_fd, IORING_REGISTER_PBUF_RING, &buf_reg, 1) < 0)
+  {
+    int error = errno;
+
+    STX_ETX_Uring_Close(p_uring);
+    errno = error;
+    return false;
+  }
+
+  for (uint32_t buf_id = 0; buf_id < bufs_cnt; buf_id++)
+  {
+    STX_ETX_Uring_PutBuf(p_uring, (uint16_t)buf_id);
+  }
+  __atomic_store_n(&p_uring->p_buf_ring->tail, p_uring->buf_tail, __ATOMIC_RELEASE);
+
+  p_uring->read_op = STX_ETX_Uring_HasMultishot(p_uring->ring_fd) ? STX_ETX_URING_OP_READ_MULTISHOT : IORING_OP_READ;
+  return true;
+}
+
+void STX_ETX_Uring_Close(STX_ETX_Uring_t * p_uring)
+{
+  if (p_uring->ring_fd >= 0)
+  {
+    close(p_uring->ring_fd);
+  }
+
+  if (NULL != p_uring->p_buf_ring)
+  {
+    munmap(p_uring->p_buf_ring, p_uring->buf_ring_size);
+  }
+
+  if (NULL != p_uring->p_sqes)
+  {
+    munmap(p_uring->p_sqes, p_uring->sqes_size);
+  }
+
+  if ((NULL != p_uring->p_cq_ring) && (p_uring->p_cq_ring != p_uring->p_sq_ring))
+  {
+    munmap(p_uring->p_cq_ring, p_uring->cq_ring_size);
+  }
+
+  if (NULL != p_uring->p_sq_ring)
+  {
+    munmap(p_uring->p_sq_ring, p_uring->sq_ring_size);
+  }
+
+  p_uring->ring_fd    = -1;
+  p_uring->p_buf_ring = NULL;
+  p_uring->p_sqes     = NULL;
+  p_uring->p_cq_ring  = NULL;
+  p_uring->p_sq_ring  = NULL;
+}
+
+bool STX_ETX_Uring_Add(STX_ETX_Uring_t *        p_uring,
+                       STX_ETX_UringSource_t *  p_source,
+                       int                      fd,
+                       STX_ETX_Config_t const * p_config,
+                       uint8_t *                p_frame,
+                       size_t                   frame_size)
+{
+  memset(p_source, 0, sizeof(*p_source));
+  p_source->fd         = fd;
+  p_source->is_open    = true;
+  STX_ETX_Source_Init(&p_source->source, p_config, p_frame, frame_size);
+
+  if (!STX_ETX_Uring_Arm(p_uring, p_source))
+  {
+    p_source->is_open = false;
+    return false;
+  }
+  return true;
+}
+
+void STX_ETX_Uring_Remove(STX_ETX_Uring_t * p_uring, STX_ETX_UringSource_t * p_source)
+{
+  p_source->is_open = false;
+
+  if (p_source->is_armed)
+  {
+    struct io_uring_sqe * p_sqe = STX_ETX_Uring_Sqe(p_uring);
+
+    /* Cancellation has no source, its own completion is ignored. */
+    if (NULL != p_sqe)
+    {
+      p_sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+      p_sqe->fd        = -1;
+      p_sqe->addr      = (uintptr_t)p_source;
+      p_sqe->user_data = 0;
+    }
+  }
+}
+
+int STX_ETX_Uring_Run(STX_ETX_Uring_t * p_uring, int timeout_ms)
+{
+  struct __kernel_timespec      timeout;
+  struct io_uring_getevents_arg arg;
+  uint32_t                      flags    = IORING_ENTER_GETEVENTS;
+  uint32_t                      wait_cnt = (0 != timeout_ms) ? 1 : 0;
+  uint32_t                      cq_head  = *p_uring->p_cq_head;
+
+  memset(&arg, 0, sizeof(arg));
+
+  if (timeout_ms > 0)
+  {
+    timeout.tv_sec  = timeout_ms / 1000;
+    timeout.tv_nsec = (timeout_ms % 1000) * 1000000LL;
+    arg.ts          = (uintptr_t)&timeout;
+    flags          |= IORING_ENTER_EXT_ARG;
+  }
+
+  if (cq_head != __atomic_load_n(p_uring->p_cq_tail, __ATOMIC_ACQUIRE))
+  {
+    wait_cnt = 0;
+  }
+
+  /* One call submits all queued reads and waits for completions. */
+  if (syscall(__NR_io_uring_enter, p_uring->ring_fd, p_uring->sq_pending, wait_cnt, flags,
+              (0 != (flags & IORING_ENTER_EXT_ARG)) ? (void *)&arg : NULL, sizeof(arg)) < 0)
+  {
+    if ((ETIME != errno) && (EINTR != errno) && (EBUSY != errno))
+    {
+      return -1;
+    }
+  }
+  p_uring->sq_pending = *p_uring->p_sq_tail - __atomic_load_n(p_uring->p_sq_head, __ATOMIC_ACQUIRE);
+
+  uint32_t cq_tail   = __atomic_load_n(p_uring->p_cq_tail, __ATOMIC_ACQUIRE);
+  int      cqes_cnt  = 0;
+
+  for (; cq_head != cq_tail; cq_head++)
+  {
+    STX_ETX_Uring_Complete(p_uring, &p_uring->p_cqes[cq_head & p_uring->cq_mask]);
+    cqes_cnt++;
+  }
+
+  __atomic_store_n(p_uring->p_cq_head, cq_head, __ATOMIC_RELEASE);
+  __atomic_store_n(&p_uring->p_buf_ring->tail, p_uring->buf_tail, __ATOMIC_RELEASE);
+  return cqes_cnt;
+}
+
+/********************************************
+ * LOCAL FUNCTION DEFINITIONS               *
+ ********************************************/
+
+static struct io_uring_sqe * STX_ETX_Uring_Sqe(STX_ETX_Uring_t * p_uring)
+{
+  if (p_uring->sq_pending == p_uring->sq_entries)
+  {
+    if (syscall(__NR_io_uring_enter, p_uring->ring_fd, p_uring->sq_pending, 0, 0, NULL, 0) < 0)
+    {
+      return NULL;
+    }
+    p_uring->sq_pending = *p_uring->p_sq_tail - __atomic_load_n(p_uring->p_sq_head, __ATOMIC_ACQUIRE);
+  }
+
+  uint32_t              sq_tail = *p_uring->p_sq_tail;
+  uint32_t              index   = sq_tail & p_uring->sq_mask;
+  struct io_uring_sqe * p_sqe   = &p_uring->p_sqes[index];
+
+  memset(p_sqe, 0, sizeof(*p_sqe));
+  p_uring->p_sq_array[index] = index;
+  p_uring->sq_pending++;
+
+  /* Entry is filled before the kernel reads it at next enter. */
+  __atomic_store_n(p_uring->p_sq_tail, sq_tail + 1, __ATOMIC_RELEASE);
+  return p_sqe;
+}
+
+static bool STX_ETX_Uring_Arm(STX_ETX_Uring_t * p_uring, STX_ETX_UringSource_t * p_source)
+{
+  struct io_uring_sqe * p_sqe = STX_ETX_Uring_Sqe(p_uring);
+
+  if (NULL == p_sqe)
+  {
+    return false;
+  }
+
+  /* Multishot read takes whole buffer, single read is limited by length. */
+  p_sqe->opcode    = p_uring->read_op;
+  p_sqe->fd        = p_source->fd;
+  p_sqe->off       = (uint64_t)-1;
+  p_sqe->len       = (IORING_OP_READ == p_uring->read_op) ? p_uring->buf_size : 0;
+  p_sqe->flags     = IOSQE_BUFFER_SELECT;
+  p_sqe->buf_group = STX_ETX_URING_BUF_GROUP;
+  p_sqe->user_data = (uintptr_t)p_source;
+
+  p_source->is_armed = true;
+  return true;
+}
+
+static void STX_ETX_Uring_PutBuf(STX_ETX_Uring_t * p_uring, uint16_t buf_id)
+{
+  struct io_uring_buf * p_buf = &p_uring->p_buf_ring->bufs[p_uring->buf_tail & (p_uring->bufs_cnt - 1)];
+
+  p_buf->addr = (uintptr_t)&p_uring->p_bufs[(size_t)buf_id * p_uring->buf_size];
+  p_buf->len  = p_uring->buf_size;
+  p_buf->bid  = buf_id;
+  p_uring->buf_tail++;
+}
+
+static void STX_ETX_Uring_Complete(STX_ETX_Uring_t * p_uring, struct io_uring_cqe const * p_cqe)
+{
+  STX_ETX_UringSource_t * p_source = (STX_ETX_UringSource_t *)(uintptr_t)p_cqe->user_data;
+
+  if (NULL == p_source)
+  {
+    return;
+  }
+
+  if (0 == (p_cqe->flags & IORING_CQE_F_MORE))
+  {
+    p_source->is_armed = false;
+  }
+
+  /* Data is decoded in place, buffer goes back to the kernel right after. */
+  if (0 != (p_cqe->flags & IORING_CQE_F_BUFFER))
+  {
+    uint16_t buf_id = (uint16_t)(p_cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+
+    if ((p_cqe->res > 0) && p_source->is_open)
+    {
+      STX_ETX_Uring_Decode(p_uring, p_source, &p_uring->p_bufs[(size_t)buf_id * p_uring->buf_size], (size_t)p_cqe->res);
+    }
+    STX_ETX_Uring_PutBuf(p_uring, buf_id);
+  }
+
+  if (!p_source->is_open)
+  {
+    return;
+  }
+
+  if ((p_cqe->res > 0) || (-ENOBUFS == p_cqe->res) || (-EINTR == p_cqe->res) || (-EAGAIN == p_cqe->res))
+  {
+    /* Read stopped by the kernel (no free buffer or single read) is queued again. */
+    if (!p_source->is_armed && !STX_ETX_Uring_Arm(p_uring, p_source))
+    {
+      p_source->error   = errno;
+      p_source->is_open = false;
+    }
+  }
+  else
+  {
+    p_source->error = -p_cqe->res;
+    STX_ETX_Uring_Remove(p_uring, p_source);
+  }
+
+  if (!p_source->is_open && (NULL != p_uring->on_close))
+  {
+    p_uring->on_close(p_uring->p_context, p_source);
+  }
+}
+
+static void STX_ETX_Uring_Decode(STX_ETX_Uring_t *       p_uring,
+                                 STX_ETX_UringSource_t * p_source,
+                                 uint8_t const *         p_in,
+                                 size_t                  in_len)
+{
+  size_t in_index = 0;
+
+  while ((in_index < in_len) && p_source->is_open)
+  {
+    size_t chunk_len = in_len - in_index;
+
+    if (STX_ETX_STATUS_DONE == STX_ETX_Source_Decode(&p_source->source, &p_in[in_index], &chunk_len))
+    {
+      p_uring->on_frame(p_uring->p_context, p_source, p_source->source.p_frame, p_source->source.frame_len);
+    }
+    in_index += chunk_len;
+  }
+}
+
+static bool STX_ETX_Uring_HasMultishot(int ring_fd)
+{
+  union
+  {
+    struct io_uring_probe probe;
+    uint8_t               raw[sizeof(struct io_uring_probe) + STX_ETX_URING_PROBE_OPS_CNT * sizeof(struct io_uring_probe_op)];
+  } probe;
+
+  memset(&probe, 0, sizeof(probe));
+
+  if (syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, &probe, STX_ETX_URING_PROBE_OPS_CNT) < 0)
+  {
+    return false;
+  }
+
+  return (probe.probe.last_op >= STX_ETX_URING_OP_READ_MULTISHOT) &&
+         (0 != (probe.probe.ops[STX_ETX_URING_OP_READ_MULTISHOT].flags & IO_URING_OP_SUPPORTED));
+}
@@ -0,0 +1,203 @@
+#ifndef STX_ETX_URING_H
+#define STX_ETX_URING_H
+
+/**
+ *  @file STX_ETX_Uring.h
+ *  @brief Header file for STX-ETX Parser io_uring ingest loop
+ *
+ *         This file contains API of io_uring loop, which reads many file
+ *         descriptors with multishot reads into buffers registered with the
+ *         kernel and decodes each completed buffer in place with parser
+ *         instance of its source. Reads of all sources are armed once and
+ *         completions are reaped in batches, so there is no syscall per read.
+ *         Linux only (kernel 5.19 or newer), built with STX_ETX_IO option.
+ *
+ *  @author Wojciech Jasko
+ */
+
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <linux/io_uring.h>
+
+#include "STX_ETX.h"
+#include "STX_ETX_Source.h"
+
+/********************************************
+ * EXPORTED #define CONSTANTS AND MACROS    *
+ ********************************************/
+
+#define STX_ETX_URING_BUFS_MAX  32768  /** Maximal number of registered read buffers. */
+
+/********************************************
+ * EXPORTED TYPES DEFINITIONS               *
+ ********************************************/
+
+/** @brief STX ETX Uring source (file descriptor with its parser). */
+typedef struct
+{
+  int                            fd;              //!< File descriptor.
+  int                            error;           //!< 0 on end of file, errno of failed read otherwise (valid, when closed).
+  bool                           is_open;         //!< True, until end of file, read error or removal.
+  bool                           is_armed;        //!< True, while read is queued in kernel (source must stay valid).
+  STX_ETX_Source_t               source;          //!< Parser with frame buffer.
+  void *                         p_user;          //!< User data.
+} STX_ETX_UringSource_t;
+
+
+/** @brief  Frame callback.
+ *
+ *  @param  p_context   Callback context.
+ *  @param  p_source    Pointer to source.
+ *  @param  p_data      Pointer to frame payload (valid until callback returns).
+ *  @param  len         Payload length.
+ **/
+typedef void (*STX_ETX_UringFrame_t)(void *                  p_context,
+                                     STX_ETX_UringSource_t * p_source,
+                                     uint8_t const *         p_data,
+                                     size_t                  len);
+
+
+/** @brief  Close callback.
+ *
+ *  @note Source is already closed, error field tells the reason.
+ *
+ *  @param  p_context   Callback context.
+ *  @param  p_source    Pointer to source.
+ **/
+typedef void (*STX_ETX_UringClose_t)(void * p_context, STX_ETX_UringSource_t * p_source);
+
+
+/** @brief STX ETX Uring loop. */
+typedef struct
+{
+  int                            ring_fd;         //!< io_uring file descriptor.
+  uint8_t                        read_op;         //!< Read operation (multishot, if supported by kernel).
+
+  /** Submission queue. */
+  void *                         p_sq_ring;       //!< Pointer to mapped submission ring.
+  size_t                         sq_ring_size;    //!< Mapped submission ring size.
+  uint32_t *                     p_sq_tail;       //!< Pointer to submission ring tail.
+  uint32_t *                     p_sq_array;      //!< Pointer to submission ring array.
+  uint32_t                       sq_mask;         //!< Submission ring mask.
+  uint32_t                       sq_pending;      //!< Number of queued, not submitted entries.
+  uint32_t                       sq_entries;      //!< Number of submission entries.
+  uint32_t *                     p_sq_head;       //!< Pointer to submission ring head.
+  struct io_uring_sqe *          p_sqes;          //!< Pointer to mapped submission entries.
+  size_t                         sqes_size;       //!< Mapped submission entries size.
+
+  /** Completion queue. */
+  void *                         p_cq_ring;       //!< Pointer to mapped completion ring (may be the same as submission ring).
+  size_t                         cq_ring_size;    //!< Mapped completion ring size.
+  uint32_t *                     p_cq_head;       //!< Pointer to completion ring head.
+  uint32_t *                     p_cq_tail;       //!< Pointer to completion ring tail.
+  uint32_t                       cq_mask;         //!< Completion ring mask.
+  struct io_uring_cqe *          p_cqes;          //!< Pointer to completion entries.
+
+  /** Registered read buffers. */
+  struct io_uring_buf_ring *     p_buf_ring;      //!< Pointer to mapped buffer ring.
+  size_t                         buf_ring_size;   //!< Mapped buffer ring size.
+  uint8_t *                      p_bufs;          //!< Pointer to read buffers.
+  uint32_t                       buf_size;        //!< Read buffer size.
+  uint16_t                       bufs_cnt;        //!< Number of read buffers (power of 2).
+  uint16_t                       buf_tail;        //!< Buffer ring tail (buffers returned to kernel).
+
+  STX_ETX_UringFrame_t           on_frame;        //!< Frame callback.
+  STX_ETX_UringClose_t           on_close;        //!< Close callback, NULL if not used.
+  void *                         p_context;       //!< Callbacks context.
+} STX_ETX_Uring_t;
+
+/********************************************
+ * EXPORTED FUNCTIONS PROTOTYPES            *
+ ********************************************/
+
+/** @brief Initialize io_uring loop.
+ *
+ *  @note Read buffers are registered with the kernel as provided buffer
+ *        ring, the kernel picks free one for each completed read.
+ *
+ *  @param [out]     p_uring    Pointer to loop.
+ *  @param [in]      entries    Number of submission entries (at least number of sources).
+ *  @param [in]      p_bufs     Pointer to read buffers (bufs_cnt * buf_size).
+ *  @param [in]      buf_size   Read buffer size.
+ *  @param [in]      bufs_cnt   Number of read buffers, power of 2 up to STX_ETX_URING_BUFS_MAX.
+ *  @param [in]      on_frame   Frame callback.
+ *  @param [in]      on_close   Close callback, NULL if not used.
+ *  @param [in]      p_context  Callbacks context.
+ *
+ *  @return bool  True, if succeeded (errno is set otherwise).
+ */
+bool STX_ETX_Uring_Init(STX_ETX_Uring_t *    p_uring,
+                        uint32_t             entries,
+                        uint8_t *            p_bufs,
+                        uint32_t             buf_size,
+                        uint32_t             bufs_cnt,
+                        STX_ETX_UringFrame_t on_frame,
+                        STX_ETX_UringClose_t on_close,
+                        void *               p_context);
+
+
+/** @brief Close io_uring loop.
+ *
+ *  @note Queued reads are cancelled. File descriptors of sources are not closed.
+ *
+ *  @param [in,out]  p_uring    Pointer to loop.
+ *
+ *  @return void.
+ */
+void STX_ETX_Uring_Close(STX_ETX_Uring_t * p_uring);
+
+
+/** @brief Add file descriptor to io_uring loop.
+ *
+ *  @note Read is queued and submitted by next run. Frame longer than frame
+ *        buffer is dropped (counted as too long).
+ *
+ *  @param [in,out]  p_uring    Pointer to loop.
+ *  @param [out]     p_source   Pointer to source (kept until it is not armed).
+ *  @param [in]      fd         File descriptor.
+ *  @param [in]      p_config   Pointer to parser configuration.
+ *  @param [in]      p_frame    Pointer to frame buffer.
+ *  @param [in]      frame_size Frame buffer size.
+ *
+ *  @return bool  True, if succeeded.
+ */
+bool STX_ETX_Uring_Add(STX_ETX_Uring_t *        p_uring,
+                       STX_ETX_UringSource_t *  p_source,
+                       int                      fd,
+                       STX_ETX_Config_t const * p_config,
+                       uint8_t *                p_frame,
+                       size_t                   frame_size);
+
+
+/** @brief Remove source from io_uring loop.
+ *
+ *  @note Queued read is cancelled, source must stay valid, until next runs
+ *        clear its is_armed flag. File descriptor is not closed.
+ *
+ *  @param [in,out]  p_uring    Pointer to loop.
+ *  @param [in,out]  p_source   Pointer to source.
+ *
+ *  @return void.
+ */
+void STX_ETX_Uring_Remove(STX_ETX_Uring_t * p_uring, STX_ETX_UringSource_t * p_source);
+
+
+/** @brief Submit queued reads, wait for completions and decode them.
+ *
+ *  @note All completions available after wait are handled, used buffers are
+ *        returned to the kernel at once. Read stopped by the kernel (e.g. no
+ *        free buffer) is queued again.
+ *
+ *  @param [in,out]  p_uring    Pointer to loop.
+ *  @param [in]      timeout_ms Wait timeout in milliseconds, -1 to wait forever.
+ *
+ *  @return int Number of completions handled, -1 if wait failed (errno is set).
+ */
+int STX_ETX_Uring_Run(STX_ETX_Uring_t * p_uring, int timeout_ms);
+
+#endif /* #ifndef STX_ETX_URING_H */
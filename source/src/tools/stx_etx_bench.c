@@ -0,0 +1,449 @@
+/**
+ *  @file stx_etx_bench.c
+ *  @brief STX-ETX Parser throughput benchmark
+ *
+ *         Measures STX_ETX_Encode and STX_ETX_Decode on synthetic workloads
+ *         across escape densities, frame sizes, CRC implementations and
+ *         input chunk sizes. Results are printed as CSV. Chunk length 0
+ *         means whole frame (encode) or whole stream (decode). CRC names
+ *         with "codec" suffix use specialized codecs (STX_ETX_Codec.h),
+ *         which encode whole frames only. Operation "decode-table" is
+ *         STX_ETX_DecodeTable.
+ *
+ *  @author Wojciech Jasko
+ */
+
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "STX_ETX.h"
+#include "STX_ETX_CRC.h"
+#include "STX_ETX_Codec.h"
+
+/********************************************
+ * LOCAL #define CONSTANTS AND MACROS       *
+ ********************************************/
+
+#define STX_ETX_BENCH_BYTES     (4 * 1024 * 1024)  /** Default payload bytes per case. */
+#define STX_ETX_BENCH_REPEATS   3                  /** Default number of repeats (best is reported). */
+
+/** @brief Number of elements of array. */
+#define STX_ETX_BENCH_COUNT(array) (sizeof(array) / sizeof((array)[0]))
+
+/********************************************
+ * LOCAL TYPES DEFINITIONS                  *
+ ********************************************/
+
+/** @brief Encode or decode function. */
+typedef STX_ETX_Status_t (*STX_ETX_BenchFunction_t)(STX_ETX_t *     p_instance,
+                                                     uint8_t const * p_in,
+                                                     size_t *        p_in_len,
+                                                     uint8_t *       p_out,
+                                                     size_t *        p_out_len);
+
+
+/** @brief CRC implementation. */
+typedef struct
+{
+  char const *                   p_name;          //!< Name.
+  STX_ETX_Config_t               config;          //!< Parser configuration.
+  STX_ETX_BenchFunction_t        p_encode;        //!< Whole frame encode function.
+  STX_ETX_BenchFunction_t        p_decode;        //!< Decode function.
+  bool                           is_codec;        //!< True, if specialized codec (no chunked encoding).
+} STX_ETX_BenchCrc_t;
+
+
+/** @brief Benchmark case. */
+typedef struct
+{
+  unsigned                       escape_pct;      //!< Percentage of payload bytes to be escaped.
+  size_t                         frame_len;       //!< Payload length of each frame.
+  STX_ETX_BenchCrc_t const *     p_crc;           //!< CRC implementation.
+  size_t                         chunk_len;       //!< Input chunk length, 0 for whole frame/stream.
+  size_t                         frames_cnt;      //!< Number of frames.
+  uint8_t *                      p_payload;       //!< Payloads of all frames.
+  uint8_t *                      p_encoded;       //!< Encoded stream.
+  size_t                         encoded_len;     //!< Encoded stream length.
+  uint8_t *                      p_out;           //!< Output buffer.
+  size_t                         out_len;         //!< Output buffer length.
+} STX_ETX_BenchCase_t;
+
+/********************************************
+ * LOCAL FUNCTIONS PROTOTYPES               *
+ ********************************************/
+
+/** @brief Update CRC16 (polynomial 0x1021) bit by bit.
+ *
+ *  @param [in]      crc16      Previous value of crc.
+ *  @param [in]      value      New byte.
+ *
+ *  @return uint16_t Updated CRC.
+ */
+static uint16_t STX_ETX_BenchUpdateCrcBitwise(uint16_t crc16, uint8_t value);
+
+
+/** @brief Generate payloads with given escape density.
+ *
+ *  @param [in,out]  p_case     Pointer to benchmark case.
+ *
+ *  @return void.
+ */
+static void STX_ETX_BenchGenerate(STX_ETX_BenchCase_t * p_case);
+
+
+/** @brief Encode all frames of benchmark case.
+ *
+ *  @param [in,out]  p_case     Pointer to benchmark case.
+ *
+ *  @return size_t Number of encoded bytes, 0 on failure.
+ */
+static size_t STX_ETX_BenchEncode(STX_ETX_BenchCase_t * p_case);
+
+
+/** @brief Decode encoded stream of benchmark case.
+ *
+ *  @param [in,out]  p_case     Pointer to benchmark case.
+ *  @param [in]      p_decode   Decode function.
+ *
+ *  @return size_t Number of decoded frames.
+ */
+static size_t STX_ETX_BenchDecode(STX_ETX_BenchCase_t * p_case, STX_ETX_BenchFunction_t p_decode);
+
+
+/** @brief Get monotonic time.
+ *
+ *  @return double Time in seconds.
+ */
+static double STX_ETX_BenchNow(void);
+
+
+/** @brief Print CSV result line.
+ *
+ *  @param [in]      p_op       Operation name.
+ *  @param [in]      p_case     Pointer to benchmark case.
+ *  @param [in]      elapsed    Best time in seconds.
+ *
+ *  @return void.
+ */
+static void STX_ETX_BenchReport(char const * p_op, STX_ETX_BenchCase_t const * p_case, double elapsed);
+
+/********************************************
+ * LOCAL CODECS                             *
+ ********************************************/
+
+STX_ETX_DEFINE_CODEC_NO_CRC(STX_ETX_BenchOff)
+STX_ETX_DEFINE_CODEC(STX_ETX_BenchTable, STX_ETX_CRC16_UpdateBlock1021, 0x0000)
+
+/********************************************
+ * LOCAL CONSTANTS                          *
+ ********************************************/
+
+static const unsigned STX_ETX_BenchEscapePcts[] = {0, 1, 10, 100};
+static const size_t   STX_ETX_BenchFrameLens[]  = {8, 64, 512, 4096, 65536};
+static const size_t   STX_ETX_BenchChunkLens[]  = {0, 4096, 256, 16};
+
+/********************************************
+ * LOCAL VARIABLES                          *
+ ********************************************/
+
+static STX_ETX_BenchCrc_t STX_ETX_BenchCrcs[] =
+{
+  {"off",         {0},                                                                      STX_ETX_Encode,            STX_ETX_Decode,            false},
+  {"bitwise",     {.initial_crc16 = 0x0000, .update_crc16 = STX_ETX_BenchUpdateCrcBitwise}, STX_ETX_Encode,            STX_ETX_Decode,            false},
+  {"table",       {0},                                                                      STX_ETX_Encode,            STX_ETX_Decode,            false},
+  {"off-codec",   {0},                                                                      STX_ETX_BenchOff_Encode,   STX_ETX_BenchOff_Decode,   true},
+  {"table-codec", {0},                                                                      STX_ETX_BenchTable_Encode, STX_ETX_BenchTable_Decode, true},
+};
+
+static uint32_t STX_ETX_BenchSeed = 0x12345678;
+
+/********************************************
+ * EXPORTED FUNCTION DEFINITIONS            *
+ ********************************************/
+
+int main(int argc, char ** argv)
+{
+  size_t bytes   = STX_ETX_BENCH_BYTES;
+  int    repeats = STX_ETX_BENCH_REPEATS;
+  int    option;
+
+  while (-1 != (option = getopt(argc, argv, "b:r:h")))
+  {
+    switch (option)
+    {
+      case 'b':
+        bytes = strtoul(optarg, NULL, 0);
+        break;
+
+      case 'r':
+        repeats = atoi(optarg);
+        repeats = (repeats > 0) ? repeats : 1;
+        break;
+
+      default:
+        fprintf(stderr,
+                "Usage: %s [-b payload_bytes_per_case] [-r repeats]\n",
+                argv[0]);
+        return ('h' == option) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+  }
+
+  STX_ETX_CRC16_GetConfig(STX_ETX_CRC16_XMODEM, &STX_ETX_BenchCrcs[2].config);
+  STX_ETX_BenchCrcs[3].config = STX_ETX_BenchOff_Config;
+  STX_ETX_BenchCrcs[4].config = STX_ETX_BenchTable_Config;
+
+  printf("op,escape_pct,frame_len,crc,chunk_len,frames,payload_bytes,encoded_bytes,mb_per_s,ns_per_frame\n");
+
+  for (size_t f = 0; f < STX_ETX_BENCH_COUNT(STX_ETX_BenchFrameLens); f++)
+  {
+    for (size_t e = 0; e < STX_ETX_BENCH_COUNT(STX_ETX_BenchEscapePcts); e++)
+    {
+      STX_ETX_BenchCase_t bench_case;
+
+      bench_case.escape_pct = STX_ETX_BenchEscapePcts[e];
+      bench_case.frame_len  = STX_ETX_BenchFrameLens[f];
+      bench_case.frames_cnt = (bytes + bench_case.frame_len - 1) / bench_case.frame_len;
+      bench_case.out_len    = 2 * bench_case.frames_cnt * (bench_case.frame_len + 4);
+      bench_case.p_payload  = malloc(bench_case.frames_cnt * bench_case.frame_len);
+      bench_case.p_encoded  = malloc(bench_case.out_len);
+      bench_case.p_out      = malloc(bench_case.out_len);
+
+      if ((NULL == bench_case.p_payload) || (NULL == bench_case.p_encoded) || (NULL == bench_case.p_out))
+      {
+        perror("malloc");
+        return EXIT_FAILURE;
+      }
+
+      STX_ETX_BenchGenerate(&bench_case);
+
+      for (size_t c = 0; c < STX_ETX_BENCH_COUNT(STX_ETX_BenchCrcs); c++)
+      {
+        bench_case.p_crc = &STX_ETX_BenchCrcs[c];
+
+        for (size_t k = 0; k < STX_ETX_BENCH_COUNT(STX_ETX_BenchChunkLens); k++)
+        {
+          double best_encode = 0;
+          double best_decode = 0;
+          double best_table  = 0;
+
+          bench_case.chunk_len = STX_ETX_BenchChunkLens[k];
+
+          for (int repeat = 0; repeat < repeats; repeat++)
+          {
+            double start = STX_ETX_BenchNow();
+
+            bench_case.encoded_len = STX_ETX_BenchEncode(&bench_case);
+
+            double encode = STX_ETX_BenchNow() - start;
+
+            start = STX_ETX_BenchNow();
+
+            size_t frames_cnt = STX_ETX_BenchDecode(&bench_case, bench_case.p_crc->p_decode);
+
+            double decode = STX_ETX_BenchNow() - start;
+
+            start = STX_ETX_BenchNow();
+
+            size_t table_frames_cnt = STX_ETX_BenchDecode(&bench_case, STX_ETX_DecodeTable);
+
+            double table = STX_ETX_BenchNow() - start;
+
+            if ((0 == bench_case.encoded_len) || (frames_cnt != bench_case.frames_cnt) || (table_frames_cnt != frames_cnt))
+            {
+              fprintf(stderr, "Benchmark case failed (decoded %zu of %zu frames)\n", frames_cnt, bench_case.frames_cnt);
+              return EXIT_FAILURE;
+            }
+
+            best_encode = ((0 == repeat) || (encode < best_encode)) ? encode : best_encode;
+            best_decode = ((0 == repeat) || (decode < best_decode)) ? decode : best_decode;
+            best_table  = ((0 == repeat) || (table < best_table))   ? table  : best_table;
+          }
+
+          if ((0 == bench_case.chunk_len) || !bench_case.p_crc->is_codec)
+          {
+            STX_ETX_BenchReport("encode", &bench_case, best_encode);
+          }
+          STX_ETX_BenchReport("decode", &bench_case, best_decode);
+
+          if (!bench_case.p_crc->is_codec)
+          {
+            STX_ETX_BenchReport("decode-table", &bench_case, best_table);
+          }
+          fflush(stdout);
+        }
+      }
+
+      free(bench_case.p_payload);
+      free(bench_case.p_encoded);
+      free(bench_case.p_out);
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+/********************************************
+ * LOCAL FUNCTION DEFINITIONS               *
+ ********************************************/
+
+static uint16_t STX_ETX_BenchUpdateCrcBitwise(uint16_t crc16, uint8_t value)
+{
+  crc16 ^= (uint16_t)(value << 8);
+
+  for (int bit = 0; bit < 8; bit++)
+  {
+    crc16 = (crc16 & 0x8000) ? (uint16_t)((crc16 << 1) ^ 0x1021) : (uint16_t)(crc16 << 1);
+  }
+  return crc16;
+}
+
+static void STX_ETX_BenchGenerate(STX_ETX_BenchCase_t * p_case)
+{
+  static const uint8_t specials[] = {STX, ETX, DLE};
+
+  size_t len = p_case->frames_cnt * p_case->frame_len;
+
+  for (size_t index = 0; index < len; index++)
+  {
+    /* xorshift32 */
+    STX_ETX_BenchSeed ^= STX_ETX_BenchSeed << 13;
+    STX_ETX_BenchSeed ^= STX_ETX_BenchSeed >> 17;
+    STX_ETX_BenchSeed ^= STX_ETX_BenchSeed << 5;
+
+    if ((STX_ETX_BenchSeed % 100) < p_case->escape_pct)
+    {
+      p_case->p_payload[index] = specials[(STX_ETX_BenchSeed >> 8) % 3];
+    }
+    else
+    {
+      uint8_t value = (uint8_t)(STX_ETX_BenchSeed >> 8);
+
+      p_case->p_payload[index] = ((STX == value) || (ETX == value) || (DLE == value)) ? (uint8_t)(value + 0x20) : value;
+    }
+  }
+}
+
+static size_t STX_ETX_BenchEncode(STX_ETX_BenchCase_t * p_case)
+{
+  STX_ETX_t stx_etx;
+  size_t    out_index = 0;
+
+  STX_ETX_Init(&stx_etx, &p_case->p_crc->config);
+
+  for (size_t frame = 0; frame < p_case->frames_cnt; frame++)
+  {
+    uint8_t const *  p_in    = &p_case->p_payload[frame * p_case->frame_len];
+    size_t           out_len = p_case->out_len - out_index;
+    STX_ETX_Status_t status;
+
+    if ((0 == p_case->chunk_len) || p_case->p_crc->is_codec)
+    {
+      size_t in_len = p_case->frame_len;
+
+      status = p_case->p_crc->p_encode(&stx_etx, p_in, &in_len, &p_case->p_encoded[out_index], &out_len);
+      out_index += out_len;
+    }
+    else
+    {
+      status = STX_ETX_EncodeBegin(&stx_etx, &p_case->p_encoded[out_index], &out_len);
+      out_index += out_len;
+
+      for (size_t in_index = 0; (in_index < p_case->frame_len) && (STX_ETX_STATUS_CONTINUE == status); )
+      {
+        size_t in_len = p_case->frame_len - in_index;
+
+        in_len  = (in_len < p_case->chunk_len) ? in_len : p_case->chunk_len;
+        out_len = p_case->out_len - out_index;
+        status  = STX_ETX_EncodeAppend(&stx_etx, &p_in[in_index], &in_len, &p_case->p_encoded[out_index], &out_len);
+
+        in_index  += in_len;
+        out_index += out_len;
+      }
+
+      out_len = p_case->out_len - out_index;
+      status  = (STX_ETX_STATUS_CONTINUE == status) ?
+                STX_ETX_EncodeFinish(&stx_etx, &p_case->p_encoded[out_index], &out_len) : status;
+      out_index += out_len;
+    }
+
+    if (STX_ETX_STATUS_DONE != status)
+    {
+      return 0;
+    }
+  }
+  return out_index;
+}
+
+static size_t STX_ETX_BenchDecode(STX_ETX_BenchCase_t * p_case, STX_ETX_BenchFunction_t p_decode)
+{
+  STX_ETX_t stx_etx;
+  size_t    frames_cnt = 0;
+  size_t    in_index   = 0;
+  size_t    out_index  = 0;
+  size_t    chunk_len  = (0 != p_case->chunk_len) ? p_case->chunk_len : p_case->encoded_len;
+
+  STX_ETX_Init(&stx_etx, &p_case->p_crc->config);
+
+  while (in_index < p_case->encoded_len)
+  {
+    size_t chunk_end = in_index + chunk_len;
+
+    chunk_end = (chunk_end < p_case->encoded_len) ? chunk_end : p_case->encoded_len;
+
+    while (in_index < chunk_end)
+    {
+      size_t           in_len  = chunk_end - in_index;
+      size_t           out_len = p_case->out_len - out_index;
+      STX_ETX_Status_t status  = p_decode(&stx_etx,
+                                          &p_case->p_encoded[in_index],
+                                          &in_len,
+                                          &p_case->p_out[out_index],
+                                          &out_len);
+
+      in_index  += in_len;
+      out_index += out_len;
+
+      if (STX_ETX_STATUS_DONE == status)
+      {
+        frames_cnt++;
+        out_index = 0;
+      }
+      else if (STX_ETX_STATUS_CONTINUE != status)
+      {
+        return frames_cnt;
+      }
+    }
+  }
+  return frames_cnt;
+}
+
+static double STX_ETX_BenchNow(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static void STX_ETX_BenchReport(char const * p_op, STX_ETX_BenchCase_t const * p_case, double elapsed)
+{
+  size_t payload_len = p_case->frames_cnt * p_case->frame_len;
+
+  printf("%s,%u,%zu,%s,%zu,%zu,%zu,%zu,%.1f,%.1f\n",
+         p_op,
+         p_case->escape_pct,
+         p_case->frame_len,
+         p_case->p_crc->p_name,
+         p_case->chunk_len,
+         p_case->frames_cnt,
+         payload_len,
+         p_case->encoded_len,
+         (elapsed > 0) ? ((double)payload_len / elapsed / 1e6) : 0.0,
+         (double)elapsed * 1e9 / (double)p_case->frames_cnt);
+}
@@ -0,0 +1,357 @@
+/**
+ *  @file stx_etx_dump.c
+ *  @brief STX-ETX capture decoder
+ *
+ *         Decodes every frame of raw capture file mapped to memory, prints
+ *         frame summaries or writes payloads out, and reports throughput,
+ *         CRC failures and resynchronization counters.
+ *
+ *  @author Wojciech Jasko
+ */
+
+/********************************************
+ * INCLUDES                                 *
+ ********************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "STX_ETX.h"
+#include "STX_ETX_CRC.h"
+
+/********************************************
+ * LOCAL #define CONSTANTS AND MACROS       *
+ ********************************************/
+
+#define STX_ETX_DUMP_OUT_LEN      (1024 * 1024)  /** Initial length of output buffer (doubled for longer frames). */
+#define STX_ETX_DUMP_PREVIEW_LEN  16             /** Number of payload bytes printed in frame summary. */
+
+/********************************************
+ * LOCAL TYPES DEFINITIONS                  *
+ ********************************************/
+
+/** @brief CRC16 preset name. */
+typedef struct
+{
+  char const *                   p_name;          //!< Name.
+  STX_ETX_CRC16_Preset_t         preset;          //!< Preset.
+} STX_ETX_DumpPreset_t;
+
+/********************************************
+ * LOCAL FUNCTIONS PROTOTYPES               *
+ ********************************************/
+
+/** @brief Print usage.
+ *
+ *  @param [in]      p_program  Program name.
+ *
+ *  @return void.
+ */
+static void STX_ETX_DumpUsage(char const * p_program);
+
+
+/** @brief Get parser configuration by CRC16 preset name.
+ *
+ *  @param [in]      p_name     Preset name.
+ *  @param [out]     p_config   Pointer to parser configuration.
+ *
+ *  @return bool  True, if preset is known.
+ */
+static bool STX_ETX_DumpGetConfig(char const * p_name, STX_ETX_Config_t * p_config);
+
+
+/** @brief Print frame summary.
+ *
+ *  @param [in]      p_file     Stream of summaries.
+ *  @param [in]      index      Frame index.
+ *  @param [in]      in_offset  Offset of frame end in capture.
+ *  @param [in]      p_payload  Pointer to payload.
+ *  @param [in]      len        Payload length.
+ *
+ *  @return void.
+ */
+static void STX_ETX_DumpFrame(FILE *          p_file,
+                              size_t          index,
+                              size_t          in_offset,
+                              uint8_t const * p_payload,
+                              size_t          len);
+
+/********************************************
+ * LOCAL CONSTANTS                          *
+ ********************************************/
+
+/** @brief CRC16 preset names. */
+static const STX_ETX_DumpPreset_t STX_ETX_DumpPresets[] =
+{
+  {"arc",         STX_ETX_CRC16_ARC},
+  {"ccitt-false", STX_ETX_CRC16_CCITT_FALSE},
+  {"modbus",      STX_ETX_CRC16_MODBUS},
+  {"xmodem",      STX_ETX_CRC16_XMODEM},
+};
+
+/********************************************
+ * EXPORTED FUNCTION DEFINITIONS            *
+ ********************************************/
+
+int main(int argc, char ** argv)
+{
+  STX_ETX_Config_t config        = {0};
+  char const *     p_out_path    = NULL;
+  size_t           max_frame_len = 0;
+  bool             quiet         = false;
+  bool             crc_payload   = false;
+  int              option;
+
+  while (-1 != (option = getopt(argc, argv, "c:m:o:pqh")))
+  {
+    switch (option)
+    {
+      case 'c':
+        if (!STX_ETX_DumpGetConfig(optarg, &config))
+        {
+          fprintf(stderr, "Unknown CRC preset: %s\n", optarg);
+          return EXIT_FAILURE;
+        }
+        break;
+
+      case 'm':
+        max_frame_len = strtoul(optarg, NULL, 0);
+        break;
+
+      case 'o':
+        p_out_path = optarg;
+        break;
+
+      case 'p':
+        crc_payload = true;
+        break;
+
+      case 'q':
+        quiet = true;
+        break;
+
+      default:
+        STX_ETX_DumpUsage(argv[0]);
+        return ('h' == option) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+  }
+
+  if (optind + 1 != argc)
+  {
+    STX_ETX_DumpUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  int         fd = open(argv[optind], O_RDONLY);
+  struct stat st;
+
+  if ((fd < 0) || (0 != fstat(fd, &st)))
+  {
+    perror(argv[optind]);
+    return EXIT_FAILURE;
+  }
+
+  size_t          in_len = (size_t)st.st_size;
+  uint8_t const * p_in   = NULL;
+
+  if (0 != in_len)
+  {
+    void * p_map = mmap(NULL, in_len, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (MAP_FAILED == p_map)
+    {
+      perror("mmap");
+      close(fd);
+      return EXIT_FAILURE;
+    }
+
+    madvise(p_map, in_len, MADV_SEQUENTIAL);
+    p_in = p_map;
+  }
+  close(fd);
+
+  FILE *    p_out_file     = NULL;
+  FILE *    p_summary_file = stdout;
+  uint8_t * p_out          = malloc(STX_ETX_DUMP_OUT_LEN);
+  size_t    out_size       = STX_ETX_DUMP_OUT_LEN;
+
+  if (NULL != p_out_path)
+  {
+    p_out_file = (0 == strcmp(p_out_path, "-")) ? stdout : fopen(p_out_path, "wb");
+
+    if (NULL == p_out_file)
+    {
+      perror(p_out_path);
+      return EXIT_FAILURE;
+    }
+
+    /* Summaries do not mix with payloads written to standard output (also as /dev/stdout). */
+    struct stat out_st;
+    struct stat stdout_st;
+
+    if ((stdout == p_out_file) ||
+        ((0 == fstat(fileno(p_out_file), &out_st)) && (0 == fstat(STDOUT_FILENO, &stdout_st)) &&
+         (out_st.st_dev == stdout_st.st_dev) && (out_st.st_ino == stdout_st.st_ino)))
+    {
+      p_summary_file = stderr;
+    }
+  }
+
+  if (NULL == p_out)
+  {
+    perror("malloc");
+    return EXIT_FAILURE;
+  }
+
+  STX_ETX_t        stx_etx;
+  STX_ETX_Resync_t resync       = {0};
+  size_t           in_index     = 0;
+  size_t           frames_cnt   = 0;
+  size_t           payload_len  = 0;
+  size_t           frame_len    = 0;
+  struct timespec  start;
+  struct timespec  end;
+
+  config.max_frame_len = max_frame_len;
+  config.crc_mode      = crc_payload ? STX_ETX_CRC_PAYLOAD : STX_ETX_CRC_WIRE;
+  STX_ETX_Init(&stx_etx, &config);
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  while (in_index < in_len)
+  {
+    size_t           dropped_cnt   = resync.inv_char_cnt + resync.inv_crc_cnt + resync.too_long_cnt;
+    size_t           chunk_in_len  = in_len - in_index;
+    size_t           chunk_out_len = out_size - frame_len;
+    STX_ETX_Status_t status        = STX_ETX_DecodeResync(&stx_etx,
+                                                          &p_in[in_index],
+                                                          &chunk_in_len,
+                                                          &p_out[frame_len],
+                                                          &chunk_out_len,
+                                                          &resync);
+
+    in_index += chunk_in_len;
+
+    /* Frame continued after OVERFLOW was dropped, the next one was written after it. */
+    if (dropped_cnt != resync.inv_char_cnt + resync.inv_crc_cnt + resync.too_long_cnt)
+    {
+      memmove(p_out, &p_out[frame_len], chunk_out_len);
+      frame_len = 0;
+    }
+    frame_len += chunk_out_len;
+
+    if (STX_ETX_STATUS_DONE == status)
+    {
+      /* Only finished frames are written, so output needs no seeking (may be a pipe). */
+      if ((NULL != p_out_file) && (0 != frame_len) && (1 != fwrite(p_out, frame_len, 1, p_out_file)))
+      {
+        perror(p_out_path);
+        return EXIT_FAILURE;
+      }
+
+      if (!quiet)
+      {
+        STX_ETX_DumpFrame(p_summary_file, frames_cnt, in_index, p_out, frame_len);
+      }
+
+      frames_cnt++;
+      payload_len += frame_len;
+      frame_len    = 0;
+    }
+    else if (frame_len == out_size)
+    {
+      /* Frame does not fit output buffer. */
+      uint8_t * p_grown = realloc(p_out, 2 * out_size);
+
+      if (NULL == p_grown)
+      {
+        perror("realloc");
+        return EXIT_FAILURE;
+      }
+
+      p_out     = p_grown;
+      out_size *= 2;
+    }
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  double elapsed = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) * 1e-9;
+
+  fprintf(stderr, "input:          %zu B\n", in_len);
+  fprintf(stderr, "frames:         %zu\n", frames_cnt);
+  fprintf(stderr, "payload:        %zu B\n", payload_len);
+  fprintf(stderr, "crc failures:   %zu\n", resync.inv_crc_cnt);
+  fprintf(stderr, "invalid frames: %zu\n", resync.inv_char_cnt);
+  fprintf(stderr, "too long:       %zu\n", resync.too_long_cnt);
+  fprintf(stderr, "skipped:        %zu B\n", resync.skipped_len);
+  fprintf(stderr, "unfinished:     %s\n",
+          ((STX_ETX_STATE_IDLE != stx_etx.state) && (STX_ETX_STATE_DISCARD != stx_etx.state)) ? "yes" : "no");
+  fprintf(stderr, "elapsed:        %.6f s\n", elapsed);
+  fprintf(stderr, "throughput:     %.1f MB/s\n", (elapsed > 0) ? ((double)in_len / elapsed / 1e6) : 0.0);
+
+  if ((NULL != p_out_file) && (0 != ((stdout == p_out_file) ? fflush(p_out_file) : fclose(p_out_file))))
+  {
+    perror(p_out_path);
+    return EXIT_FAILURE;
+  }
+
+  if (0 != in_len)
+  {
+    munmap((void *)p_in, in_len);
+  }
+  free(p_out);
+  return EXIT_SUCCESS;
+}
+
+/********************************************
+ * LOCAL FUNCTION DEFINITIONS               *
+ ********************************************/
+
+static void STX_ETX_DumpUsage(char const * p_program)
+{
+  fprintf(stderr,
+          "Usage: %s [-c preset] [-m max_len] [-o payload_file] [-p] [-q] capture_file\n"
+          "  -c preset        CRC16 preset: arc, ccitt-false, modbus, xmodem (default: no CRC)\n"
+          "  -m max_len       Drop frames with payload longer than max_len (default: no limit)\n"
+          "  -o payload_file  Write payloads of valid frames to file (- for standard output,\n"
+          "                   frame summaries are printed to standard error then)\n"
+          "  -p               CRC covers payload only (default: whole frame)\n"
+          "  -q               Do not print frame summaries\n",
+          p_program);
+}
+
+static bool STX_ETX_DumpGetConfig(char const * p_name, STX_ETX_Config_t * p_config)
+{
+  for (size_t index = 0; index < sizeof(STX_ETX_DumpPresets) / sizeof(STX_ETX_DumpPresets[0]); index++)
+  {
+    if (0 == strcmp(p_name, STX_ETX_DumpPresets[index].p_name))
+    {
+      return STX_ETX_CRC16_GetConfig(STX_ETX_DumpPresets[index].preset, p_config);
+    }
+  }
+  return false;
+}
+
+static void STX_ETX_DumpFrame(FILE *          p_file,
+                              size_t          index,
+                              size_t          in_offset,
+                              uint8_t const * p_payload,
+                              size_t          len)
+{
+  size_t preview_len = (len < STX_ETX_DUMP_PREVIEW_LEN) ? len : STX_ETX_DUMP_PREVIEW_LEN;
+
+  fprintf(p_file, "%zu\t%zu\t%zu\t", index, in_offset, len);
+
+  for (size_t i = 0; i < preview_len; i++)
+  {
+    fprintf(p_file, "%02X", p_payload[i]);
+  }
+
+  fprintf(p_file, "%s\n", (len > preview_len) ? "..." : "");
+}
@@ -22,6 +22,13 @@ const STX_ETX_Config_t TC_ConfigCRC =
   .update_crc16  = TC_UpdateCrc,
 };
 
+const STX_ETX_Config_t TC_ConfigPayloadCRC =
+{
+  .initial_crc16 = CRC16_INIT,
+  .update_crc16  = TC_UpdateCrc,
+  .crc_mode      = STX_ETX_CRC_PAYLOAD,
+};
+
 void setUp(void)
 {
 
@@ -554,4 +561,749 @@ void test_DoubleEncodeCRCSuccess(void)
             expected_decoded1,
             sizeof(expected_decoded1),
             sizeof(expected_decoded1));
-}
\ No newline at end of file
+}
+
+void test_StreamDecodeNoCRCSuccess_LongRun(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigNoCRC);
+
+  uint8_t encoded[1 + 40 + 2 + 3 + 1];
+  uint8_t decoded[40 + 1 + 3];
+
+  encoded[0] = STX;
+  for (size_t i = 0; i < 40; i++)
+  {
+    encoded[1 + i] = (uint8_t)(0x40 + i);
+    decoded[i]     = (uint8_t)(0x40 + i);
+  }
+  encoded[41] = DLE;
+  encoded[42] = ETX;
+  decoded[40] = ETX;
+  for (size_t i = 0; i < 3; i++)
+  {
+    encoded[43 + i] = (uint8_t)(0x80 + i);
+    decoded[41 + i] = (uint8_t)(0x80 + i);
+  }
+  encoded[46] = ETX;
+
+  /* Output overflow in the middle of the run. */
+  TC_Decode(&stx_etx,
+            STX_ETX_STATUS_OVERFLOW,
+            encoded,
+            1 + 33,
+            sizeof(encoded),
+            decoded,
+            33,
+            33);
+
+  /* Input ends with DLE. */
+  TC_Decode(&stx_etx,
+            STX_ETX_STATUS_CONTINUE,
+            &encoded[34],
+            8,
+            8,
+            &decoded[33],
+            7,
+            7);
+
+  TC_Decode(&stx_etx,
+            STX_ETX_STATUS_DONE,
+            &encoded[42],
+            5,
+            5,
+            &decoded[40],
+            4,
+            4);
+}
+
+void test_StreamEncodeCRCSuccess_LongRun(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+
+  uint8_t decoded[40];
+  uint8_t expected_encoded[1 + 40 + 1 + 1 + 2];
+  uint8_t encoded[sizeof(expected_encoded)];
+
+  for (size_t i = 0; i < sizeof(decoded); i++)
+  {
+    decoded[i] = (uint8_t)(0x40 + i);
+  }
+  decoded[20] = DLE;
+
+  size_t index = 0;
+  expected_encoded[index++] = STX;
+  for (size_t i = 0; i < sizeof(decoded); i++)
+  {
+    if (DLE == decoded[i])
+    {
+      expected_encoded[index++] = DLE;
+    }
+    expected_encoded[index++] = decoded[i];
+  }
+  expected_encoded[index++] = ETX;
+
+  uint16_t crc = CRC16_INIT;
+  for (size_t i = 0; i < index; i++)
+  {
+    crc = TC_UpdateCrc(crc, expected_encoded[i]);
+  }
+  expected_encoded[index++] = (uint8_t)crc;
+  expected_encoded[index++] = (uint8_t)(crc >> 8);
+
+  /* Output ends between DLE and escaped character. */
+  size_t           decoded_len = sizeof(decoded);
+  size_t           encoded_len = 22;
+  STX_ETX_Status_t status      = STX_ETX_Encode(&stx_etx, decoded, &decoded_len, encoded, &encoded_len);
+
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_OVERFLOW, status);
+  TEST_ASSERT_EQUAL(20, decoded_len);
+  TEST_ASSERT_EQUAL(22, encoded_len);
+
+  size_t offset_in  = decoded_len;
+  size_t offset_out = encoded_len;
+
+  decoded_len = sizeof(decoded) - offset_in;
+  encoded_len = sizeof(encoded) - offset_out;
+  status      = STX_ETX_Encode(&stx_etx, &decoded[offset_in], &decoded_len, &encoded[offset_out], &encoded_len);
+
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(sizeof(decoded) - offset_in, decoded_len);
+  TEST_ASSERT_EQUAL(sizeof(encoded) - offset_out, encoded_len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_encoded, encoded, sizeof(encoded));
+}
+
+void test_DecodeBatchCRC(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+
+  const uint8_t encoded[] = {STX, 0x00, 0x01, DLE, STX, ETX, 0x92, 0xE9,
+                             STX, 0x00, 0x01, DLE, ETX, ETX, 0x01, 0x02,
+                             STX, 0x00, 0x01, ETX, 0x2E, 0x2E,
+                             STX, 0x05};
+  const uint8_t expected_decoded[] = {0x00, 0x01, STX, 0x00, 0x01, 0x05};
+
+  uint8_t         decoded[sizeof(encoded)];
+  STX_ETX_Frame_t frames[8];
+
+  size_t           encoded_len = sizeof(encoded);
+  size_t           decoded_len = sizeof(decoded);
+  size_t           frames_cnt  = 8;
+  STX_ETX_Status_t status      = STX_ETX_DecodeBatch(&stx_etx,
+                                                     encoded,
+                                                     &encoded_len,
+                                                     decoded,
+                                                     &decoded_len,
+                                                     frames,
+                                                     &frames_cnt);
+
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_CONTINUE, status);
+  TEST_ASSERT_EQUAL(sizeof(encoded), encoded_len);
+  TEST_ASSERT_EQUAL(sizeof(expected_decoded), decoded_len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_decoded, decoded, decoded_len);
+  TEST_ASSERT_EQUAL(4, frames_cnt);
+
+  TEST_ASSERT_EQUAL(0, frames[0].offset);
+  TEST_ASSERT_EQUAL(3, frames[0].len);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, frames[0].status);
+
+  TEST_ASSERT_EQUAL(3, frames[1].offset);
+  TEST_ASSERT_EQUAL(0, frames[1].len);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_INV_CRC, frames[1].status);
+
+  TEST_ASSERT_EQUAL(3, frames[2].offset);
+  TEST_ASSERT_EQUAL(2, frames[2].len);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, frames[2].status);
+
+  TEST_ASSERT_EQUAL(5, frames[3].offset);
+  TEST_ASSERT_EQUAL(1, frames[3].len);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, frames[3].status);
+}
+
+void test_DecodeBatchFramesExhausted(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigNoCRC);
+
+  const uint8_t encoded[] = {STX, 0x00, ETX, STX, 0x01, ETX, STX, 0x02, ETX};
+
+  uint8_t         decoded[sizeof(encoded)];
+  STX_ETX_Frame_t frames[2];
+
+  size_t           encoded_len = sizeof(encoded);
+  size_t           decoded_len = sizeof(decoded);
+  size_t           frames_cnt  = 2;
+  STX_ETX_Status_t status      = STX_ETX_DecodeBatch(&stx_etx,
+                                                     encoded,
+                                                     &encoded_len,
+                                                     decoded,
+                                                     &decoded_len,
+                                                     frames,
+                                                     &frames_cnt);
+
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_OVERFLOW, status);
+  TEST_ASSERT_EQUAL(6, encoded_len);
+  TEST_ASSERT_EQUAL(2, decoded_len);
+  TEST_ASSERT_EQUAL(2, frames_cnt);
+  TEST_ASSERT_EQUAL(1, frames[1].offset);
+  TEST_ASSERT_EQUAL(1, frames[1].len);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, frames[1].status);
+}
+
+void test_DecodeInPlaceCRC(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+
+  uint8_t buf[] = {STX, 0x00, 0x01, DLE, DLE, ETX, 0x92, 0x85,
+                   STX, 0x00, 0x01, DLE, ETX, ETX, 0x91, 0x6F,
+                   STX, 0x07};
+  const uint8_t expected_decoded[] = {0x00, 0x01, DLE, 0x00, 0x01, ETX, 0x07};
+
+  STX_ETX_Frame_t frames[4];
+
+  size_t           buf_len    = sizeof(buf);
+  size_t           frames_cnt = 4;
+  STX_ETX_Status_t status     = STX_ETX_DecodeInPlace(&stx_etx, buf, &buf_len, frames, &frames_cnt);
+
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_CONTINUE, status);
+  TEST_ASSERT_EQUAL(sizeof(buf), buf_len);
+  TEST_ASSERT_EQUAL(3, frames_cnt);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_decoded, buf, sizeof(expected_decoded));
+
+  TEST_ASSERT_EQUAL(3, frames[1].offset);
+  TEST_ASSERT_EQUAL(3, frames[1].len);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, frames[1].status);
+
+  TEST_ASSERT_EQUAL(6, frames[2].offset);
+  TEST_ASSERT_EQUAL(1, frames[2].len);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, frames[2].status);
+}
+
+void test_DecodeViewCRC(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+
+  const uint8_t encoded[] = {STX, 0x00, 0x01, ETX, 0x2E, 0x2E,
+                             STX, 0x00, 0x01, DLE, STX, ETX, 0x92, 0xE9};
+  const uint8_t expected_decoded[] = {0x00, 0x01, STX};
+
+  uint8_t         decoded[sizeof(expected_decoded)];
+  uint8_t const * p_data;
+  size_t          data_len;
+
+  /* Escape-free frame is not copied. */
+  size_t           encoded_len = sizeof(encoded);
+  size_t           decoded_len = 0;
+  STX_ETX_Status_t status      = STX_ETX_DecodeView(&stx_etx,
+                                                    encoded,
+                                                    &encoded_len,
+                                                    decoded,
+                                                    &decoded_len,
+                                                    &p_data,
+                                                    &data_len);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(6, encoded_len);
+  TEST_ASSERT_EQUAL(0, decoded_len);
+  TEST_ASSERT_EQUAL_PTR(&encoded[1], p_data);
+  TEST_ASSERT_EQUAL(2, data_len);
+
+  /* Escaped frame is copied. */
+  encoded_len = sizeof(encoded) - 6;
+  decoded_len = sizeof(decoded);
+  status      = STX_ETX_DecodeView(&stx_etx,
+                                   &encoded[6],
+                                   &encoded_len,
+                                   decoded,
+                                   &decoded_len,
+                                   &p_data,
+                                   &data_len);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(sizeof(encoded) - 6, encoded_len);
+  TEST_ASSERT_EQUAL(sizeof(expected_decoded), decoded_len);
+  TEST_ASSERT_EQUAL_PTR(decoded, p_data);
+  TEST_ASSERT_EQUAL(sizeof(expected_decoded), data_len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_decoded, decoded, decoded_len);
+}
+
+void test_DecodeViewSplitInput(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+
+  const uint8_t encoded[] = {STX, 0x00, 0x01, ETX, 0x2E};
+
+  uint8_t         decoded[2];
+  uint8_t const * p_data;
+  size_t          data_len;
+
+  size_t           encoded_len = sizeof(encoded);
+  size_t           decoded_len = sizeof(decoded);
+  STX_ETX_Status_t status      = STX_ETX_DecodeView(&stx_etx,
+                                                    encoded,
+                                                    &encoded_len,
+                                                    decoded,
+                                                    &decoded_len,
+                                                    &p_data,
+                                                    &data_len);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, status);
+  TEST_ASSERT_EQUAL(sizeof(encoded), encoded_len);
+  TEST_ASSERT_EQUAL(2, decoded_len);
+  TEST_ASSERT_EQUAL_PTR(decoded, p_data);
+  TEST_ASSERT_EQUAL(2, data_len);
+}
+
+void test_StreamEncodeCRCSuccess_BeginAppendFinish(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+
+  const uint8_t decoded0[]         = {0x00};
+  const uint8_t decoded1[]         = {0x01, ETX};
+  const uint8_t expected_encoded[] = {STX, 0x00, 0x01, DLE, ETX, ETX, 0x91, 0x6F};
+
+  uint8_t encoded[sizeof(expected_encoded)];
+  size_t  offset = 0;
+
+  size_t out_len = 1;
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_CONTINUE, STX_ETX_EncodeBegin(&stx_etx, &encoded[offset], &out_len));
+  TEST_ASSERT_EQUAL(1, out_len);
+  offset += out_len;
+
+  size_t in_len = sizeof(decoded0);
+  out_len       = sizeof(encoded) - offset;
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_CONTINUE, STX_ETX_EncodeAppend(&stx_etx, decoded0, &in_len, &encoded[offset], &out_len));
+  TEST_ASSERT_EQUAL(sizeof(decoded0), in_len);
+  TEST_ASSERT_EQUAL(1, out_len);
+  offset += out_len;
+
+  in_len  = sizeof(decoded1);
+  out_len = sizeof(encoded) - offset;
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_CONTINUE, STX_ETX_EncodeAppend(&stx_etx, decoded1, &in_len, &encoded[offset], &out_len));
+  TEST_ASSERT_EQUAL(sizeof(decoded1), in_len);
+  TEST_ASSERT_EQUAL(3, out_len);
+  offset += out_len;
+
+  /* Output ends between CRC bytes. */
+  out_len = 2;
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_OVERFLOW, STX_ETX_EncodeFinish(&stx_etx, &encoded[offset], &out_len));
+  TEST_ASSERT_EQUAL(2, out_len);
+  offset += out_len;
+
+  out_len = sizeof(encoded) - offset;
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_DONE, STX_ETX_EncodeFinish(&stx_etx, &encoded[offset], &out_len));
+  TEST_ASSERT_EQUAL(1, out_len);
+
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_encoded, encoded, sizeof(expected_encoded));
+}
+
+void test_StreamEncodeVCRCSuccess(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+
+  const uint8_t        decoded0[]         = {0x00, 0x01};
+  const uint8_t        decoded1[]         = {DLE};
+  const STX_ETX_Span_t spans[]            = {{decoded0, sizeof(decoded0)}, {NULL, 0}, {decoded1, sizeof(decoded1)}};
+  const uint8_t        expected_encoded[] = {STX, 0x00, 0x01, DLE, DLE, ETX, 0x92, 0x85};
+
+  uint8_t encoded[sizeof(expected_encoded)];
+  size_t  in_offset = 0;
+
+  /* Output ends between DLE and escaped character. */
+  size_t out_len = 4;
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_OVERFLOW, STX_ETX_EncodeV(&stx_etx, spans, 3, &in_offset, encoded, &out_len));
+  TEST_ASSERT_EQUAL(2, in_offset);
+  TEST_ASSERT_EQUAL(4, out_len);
+
+  out_len = sizeof(encoded) - 4;
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_DONE, STX_ETX_EncodeV(&stx_etx, spans, 3, &in_offset, &encoded[4], &out_len));
+  TEST_ASSERT_EQUAL(3, in_offset);
+  TEST_ASSERT_EQUAL(sizeof(encoded) - 4, out_len);
+
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_encoded, encoded, sizeof(expected_encoded));
+}
+
+void test_EncodedSize(void)
+{
+  uint8_t decoded[100];
+
+  for (size_t i = 0; i < sizeof(decoded); i++)
+  {
+    decoded[i] = (uint8_t)i;
+  }
+
+  /* STX, ETX and DLE are escaped once each. */
+  TEST_ASSERT_EQUAL(1 + 100 + 3 + 1, STX_ETX_EncodedSize(&TC_ConfigNoCRC, decoded, sizeof(decoded)));
+  TEST_ASSERT_EQUAL(1 + 100 + 3 + 1 + 2, STX_ETX_EncodedSize(&TC_ConfigCRC, decoded, sizeof(decoded)));
+  TEST_ASSERT_EQUAL(1 + 1 + 2, STX_ETX_EncodedSize(&TC_ConfigCRC, NULL, 0));
+
+  const STX_ETX_Span_t spans[] = {{decoded, 3}, {&decoded[3], 50}, {&decoded[53], 47}};
+
+  TEST_ASSERT_EQUAL(1 + 100 + 3 + 1 + 2, STX_ETX_EncodedSizeV(&TC_ConfigCRC, spans, 3));
+}
+
+void test_DecodeResyncCRC(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+
+  const uint8_t encoded[] = {0xFF, ETX, 0x00,
+                             STX, 0x00, 0x01, DLE, ETX, ETX, 0x01, 0x02,
+                             DLE, 0x55,
+                             STX, 0x00, DLE, 0x12,
+                             STX, 0x07,
+                             STX, 0x00, 0x01, DLE, ETX, ETX, 0x91, 0x6F,
+                             0xFF};
+  const uint8_t expected_decoded[] = {0x00, 0x01, ETX};
+
+  uint8_t          decoded[sizeof(encoded)];
+  STX_ETX_Resync_t resync = {0};
+
+  size_t           encoded_len = sizeof(encoded);
+  size_t           decoded_len = sizeof(decoded);
+  STX_ETX_Status_t status      = STX_ETX_DecodeResync(&stx_etx,
+                                                      encoded,
+                                                      &encoded_len,
+                                                      decoded,
+                                                      &decoded_len,
+                                                      &resync);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(sizeof(encoded) - 1, encoded_len);
+  TEST_ASSERT_EQUAL(sizeof(expected_decoded), decoded_len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_decoded, decoded, decoded_len);
+  TEST_ASSERT_EQUAL(3 + 2, resync.skipped_len);
+  TEST_ASSERT_EQUAL(2, resync.inv_char_cnt);
+  TEST_ASSERT_EQUAL(1, resync.inv_crc_cnt);
+
+  encoded_len = 1;
+  decoded_len = sizeof(decoded);
+  status      = STX_ETX_DecodeResync(&stx_etx,
+                                     &encoded[sizeof(encoded) - 1],
+                                     &encoded_len,
+                                     decoded,
+                                     &decoded_len,
+                                     &resync);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, status);
+  TEST_ASSERT_EQUAL(1, encoded_len);
+  TEST_ASSERT_EQUAL(0, decoded_len);
+  TEST_ASSERT_EQUAL(3 + 2 + 1, resync.skipped_len);
+}
+
+void test_DecodeTableCRC(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+
+  const uint8_t encoded[] = {0xFF,
+                             STX, 0x00, 0x01, DLE, STX, ETX, 0x92, 0xE9,
+                             STX, 0x00, 0x01, DLE, STX, ETX, 0x92, 0xE8};
+  const uint8_t expected_decoded[] = {0x00, 0x01, STX};
+
+  uint8_t decoded[sizeof(expected_decoded)];
+
+  /* Garbage before frame. */
+  size_t           encoded_len = sizeof(encoded);
+  size_t           decoded_len = sizeof(decoded);
+  STX_ETX_Status_t status      = STX_ETX_DecodeTable(&stx_etx, encoded, &encoded_len, decoded, &decoded_len);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_INV_CHAR, status);
+  TEST_ASSERT_EQUAL(1, encoded_len);
+  TEST_ASSERT_EQUAL(0, decoded_len);
+
+  /* Frame split at escape. */
+  encoded_len = 4;
+  decoded_len = sizeof(decoded);
+  status      = STX_ETX_DecodeTable(&stx_etx, &encoded[1], &encoded_len, decoded, &decoded_len);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, status);
+  TEST_ASSERT_EQUAL(4, encoded_len);
+  TEST_ASSERT_EQUAL(2, decoded_len);
+  TEST_ASSERT_EQUAL(STX_ETX_STATE_DLE_LATCHED, stx_etx.state);
+
+  encoded_len = sizeof(encoded) - 5;
+  decoded_len = sizeof(decoded) - 2;
+  status      = STX_ETX_DecodeTable(&stx_etx, &encoded[5], &encoded_len, &decoded[2], &decoded_len);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(4, encoded_len);
+  TEST_ASSERT_EQUAL(1, decoded_len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_decoded, decoded, sizeof(expected_decoded));
+
+  /* Invalid CRC. */
+  encoded_len = sizeof(encoded) - 9;
+  decoded_len = sizeof(decoded);
+  status      = STX_ETX_DecodeTable(&stx_etx, &encoded[9], &encoded_len, decoded, &decoded_len);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_INV_CRC, status);
+  TEST_ASSERT_EQUAL(sizeof(encoded) - 9, encoded_len);
+  TEST_ASSERT_EQUAL(STX_ETX_STATE_IDLE, stx_etx.state);
+}
+
+void test_DecodeTableOverflow(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigNoCRC);
+
+  const uint8_t encoded[] = {STX, 0x00, DLE, DLE, ETX};
+  const uint8_t expected_decoded[] = {0x00, DLE};
+
+  uint8_t decoded[sizeof(expected_decoded)];
+
+  /* DLE is processed without output space, escaped DLE is not. */
+  size_t           encoded_len = sizeof(encoded);
+  size_t           decoded_len = 1;
+  STX_ETX_Status_t status      = STX_ETX_DecodeTable(&stx_etx, encoded, &encoded_len, decoded, &decoded_len);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_OVERFLOW, status);
+  TEST_ASSERT_EQUAL(3, encoded_len);
+  TEST_ASSERT_EQUAL(1, decoded_len);
+  TEST_ASSERT_EQUAL(STX_ETX_STATE_DLE_LATCHED, stx_etx.state);
+
+  encoded_len = sizeof(encoded) - 3;
+  decoded_len = sizeof(decoded) - 1;
+  status      = STX_ETX_DecodeTable(&stx_etx, &encoded[3], &encoded_len, &decoded[1], &decoded_len);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(2, encoded_len);
+  TEST_ASSERT_EQUAL(1, decoded_len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_decoded, decoded, sizeof(expected_decoded));
+}
+
+void test_DecodeMaxFrameLen(void)
+{
+  STX_ETX_Config_t config = TC_ConfigNoCRC;
+  STX_ETX_t        stx_etx;
+
+  config.max_frame_len = 3;
+  STX_ETX_Init(&stx_etx, &config);
+
+  const uint8_t encoded[] = {STX, 0x00, 0x01, 0x04, ETX,
+                             STX, 0x00, 0x01, DLE, STX, 0x04, 0x05, ETX,
+                             STX, 0x06, ETX};
+
+  uint8_t decoded[8];
+
+  /* Frame of maximal length is accepted. */
+  size_t           encoded_len = sizeof(encoded);
+  size_t           decoded_len = sizeof(decoded);
+  STX_ETX_Status_t status      = STX_ETX_Decode(&stx_etx, encoded, &encoded_len, decoded, &decoded_len);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(5, encoded_len);
+  TEST_ASSERT_EQUAL(3, decoded_len);
+
+  /* Longer frame is rejected at first byte over limit. */
+  encoded_len = 6;
+  decoded_len = sizeof(decoded);
+  status      = STX_ETX_Decode(&stx_etx, &encoded[5], &encoded_len, decoded, &decoded_len);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_TOO_LONG, status);
+  TEST_ASSERT_EQUAL(6, encoded_len);
+  TEST_ASSERT_EQUAL(3, decoded_len);
+  TEST_ASSERT_EQUAL(STX_ETX_STATE_DISCARD, stx_etx.state);
+
+  /* Rest of the frame is skipped up to next STX. */
+  encoded_len = sizeof(encoded) - 11;
+  decoded_len = sizeof(decoded);
+  status      = STX_ETX_Decode(&stx_etx, &encoded[11], &encoded_len, decoded, &decoded_len);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(sizeof(encoded) - 11, encoded_len);
+  TEST_ASSERT_EQUAL(1, decoded_len);
+  TEST_ASSERT_EQUAL_HEX8(0x06, decoded[0]);
+}
+
+void test_DecodeTableMaxFrameLen(void)
+{
+  STX_ETX_Config_t config = TC_ConfigNoCRC;
+  STX_ETX_t        stx_etx;
+
+  config.max_frame_len = 3;
+  STX_ETX_Init(&stx_etx, &config);
+
+  const uint8_t encoded[] = {STX, 0x00, DLE, ETX, 0x01, 0x04, 0x05, ETX,
+                             STX, 0x06, ETX};
+
+  uint8_t decoded[8];
+
+  size_t           encoded_len = sizeof(encoded);
+  size_t           decoded_len = sizeof(decoded);
+  STX_ETX_Status_t status      = STX_ETX_DecodeTable(&stx_etx, encoded, &encoded_len, decoded, &decoded_len);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_TOO_LONG, status);
+  TEST_ASSERT_EQUAL(6, encoded_len);
+  TEST_ASSERT_EQUAL(3, decoded_len);
+  TEST_ASSERT_EQUAL(STX_ETX_STATE_DISCARD, stx_etx.state);
+
+  encoded_len = sizeof(encoded) - 6;
+  decoded_len = sizeof(decoded);
+  status      = STX_ETX_DecodeTable(&stx_etx, &encoded[6], &encoded_len, decoded, &decoded_len);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(sizeof(encoded) - 6, encoded_len);
+  TEST_ASSERT_EQUAL(1, decoded_len);
+  TEST_ASSERT_EQUAL_HEX8(0x06, decoded[0]);
+}
+
+void test_EncodeBatch(void)
+{
+  STX_ETX_t       stx_etx;
+  uint8_t         decoded[100];
+  uint8_t         encoded[256];
+  uint8_t         expected[256];
+  STX_ETX_Frame_t frames[4];
+
+  for (size_t i = 0; i < sizeof(decoded); i++)
+  {
+    decoded[i] = (uint8_t)i;
+  }
+
+  const STX_ETX_Span_t msgs[] = {{decoded, 3}, {NULL, 0}, {&decoded[3], 50}, {&decoded[53], 47}};
+
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+
+  /* Frames are the same as encoded one by one. */
+  size_t expected_len = 0;
+
+  for (size_t i = 0; i < 4; i++)
+  {
+    size_t in_len  = msgs[i].len;
+    size_t out_len = sizeof(expected) - expected_len;
+
+    TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Encode(&stx_etx, msgs[i].p_data, &in_len, &expected[expected_len], &out_len));
+    expected_len += out_len;
+  }
+
+  size_t msgs_cnt = 4;
+  size_t out_len  = sizeof(encoded);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_EncodeBatch(&stx_etx, msgs, &msgs_cnt, encoded, &out_len, frames));
+  TEST_ASSERT_EQUAL(4, msgs_cnt);
+  TEST_ASSERT_EQUAL(expected_len, out_len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, encoded, expected_len);
+
+  size_t offset = 0;
+
+  for (size_t i = 0; i < 4; i++)
+  {
+    TEST_ASSERT_EQUAL(offset, frames[i].offset);
+    TEST_ASSERT_EQUAL(STX_ETX_EncodedSize(&TC_ConfigCRC, msgs[i].p_data, msgs[i].len), frames[i].len);
+    TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, frames[i].status);
+    offset += frames[i].len;
+  }
+
+  /* Frame, which does not fit, is not written, the rest is encoded by next call. */
+  msgs_cnt = 4;
+  out_len  = frames[2].offset + frames[2].len - 1;
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_OVERFLOW, STX_ETX_EncodeBatch(&stx_etx, msgs, &msgs_cnt, encoded, &out_len, frames));
+  TEST_ASSERT_EQUAL(2, msgs_cnt);
+  TEST_ASSERT_EQUAL(frames[2].offset, out_len);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATE_IDLE, stx_etx.state);
+
+  size_t rest_cnt = 2;
+  size_t rest_len = sizeof(encoded) - out_len;
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_EncodeBatch(&stx_etx, &msgs[2], &rest_cnt, &encoded[out_len], &rest_len, &frames[2]));
+  TEST_ASSERT_EQUAL(2, rest_cnt);
+  TEST_ASSERT_EQUAL(expected_len, out_len + rest_len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, encoded, expected_len);
+
+  /* Output too small for any frame. */
+  msgs_cnt = 4;
+  out_len  = 3;
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_OVERFLOW, STX_ETX_EncodeBatch(&stx_etx, msgs, &msgs_cnt, encoded, &out_len, frames));
+  TEST_ASSERT_EQUAL(0, msgs_cnt);
+  TEST_ASSERT_EQUAL(0, out_len);
+}
+
+void test_PayloadCRC(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigPayloadCRC);
+
+  const uint8_t data[] = {0x00, STX, 0x01, DLE, ETX, 0x7F};
+
+  uint8_t encoded[2 * sizeof(data) + 5];
+  uint8_t decoded[sizeof(data)];
+
+  /* CRC is computed over payload only. */
+  uint16_t crc16 = CRC16_INIT;
+
+  for (size_t i = 0; i < sizeof(data); i++)
+  {
+    crc16 = TC_UpdateCrc(crc16, data[i]);
+  }
+
+  size_t data_len    = sizeof(data);
+  size_t encoded_len = sizeof(encoded);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Encode(&stx_etx, data, &data_len, encoded, &encoded_len));
+  TEST_ASSERT_EQUAL(sizeof(data) + 3 + 4, encoded_len);
+  TEST_ASSERT_EQUAL_HEX8(crc16 & UINT8_MAX, encoded[encoded_len - 2]);
+  TEST_ASSERT_EQUAL_HEX8(crc16 >> 8, encoded[encoded_len - 1]);
+
+  /* Byte-wise, table and view decoders accept it, split at escape. */
+  STX_ETX_Status_t (*const decoders[])(STX_ETX_t *, uint8_t const *, size_t *, uint8_t *, size_t *) =
+  {
+    STX_ETX_Decode,
+    STX_ETX_DecodeTable,
+  };
+
+  for (size_t i = 0; i < sizeof(decoders) / sizeof(decoders[0]); i++)
+  {
+    size_t in_len  = 4;
+    size_t out_len = sizeof(decoded);
+
+    TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, decoders[i](&stx_etx, encoded, &in_len, decoded, &out_len));
+    TEST_ASSERT_EQUAL(4, in_len);
+    TEST_ASSERT_EQUAL(2, out_len);
+
+    size_t rest_len = sizeof(decoded) - out_len;
+
+    in_len = encoded_len - 4;
+    TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, decoders[i](&stx_etx, &encoded[4], &in_len, &decoded[2], &rest_len));
+    TEST_ASSERT_EQUAL(encoded_len - 4, in_len);
+    TEST_ASSERT_EQUAL(sizeof(data) - 2, rest_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(data, decoded, sizeof(data));
+  }
+
+  uint8_t const * p_data;
+  size_t          view_len;
+  size_t          in_len  = encoded_len;
+  size_t          out_len = sizeof(decoded);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_DecodeView(&stx_etx, encoded, &in_len, decoded, &out_len, &p_data, &view_len));
+  TEST_ASSERT_EQUAL(sizeof(data), view_len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(data, p_data, view_len);
+
+  /* Escape-free frame is checked in place. */
+  const uint8_t plain[] = {0x11, 0x22, 0x33};
+
+  data_len    = sizeof(plain);
+  encoded_len = sizeof(encoded);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Encode(&stx_etx, plain, &data_len, encoded, &encoded_len));
+
+  in_len  = encoded_len;
+  out_len = 0;
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_DecodeView(&stx_etx, encoded, &in_len, decoded, &out_len, &p_data, &view_len));
+  TEST_ASSERT_EQUAL_PTR(&encoded[1], p_data);
+  TEST_ASSERT_EQUAL(sizeof(plain), view_len);
+
+  /* Frame is rejected by decoder computing CRC over wire bytes. */
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+
+  in_len  = encoded_len;
+  out_len = sizeof(decoded);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_INV_CRC, STX_ETX_Decode(&stx_etx, encoded, &in_len, decoded, &out_len));
+}
@@ -0,0 +1,174 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "STX_ETX.h"
+#include "STX_ETX_CRC.h"
+#include "STX_ETX_Alloc.h"
+
+#include "unity.h"
+
+
+#define TC_BIG_FRAME_LEN  (1024 * 1024)
+
+static const STX_ETX_Config_t TC_ConfigNoCRC = {0};
+static STX_ETX_Config_t       TC_ConfigCRC;
+
+static uint8_t                TC_Payload[TC_BIG_FRAME_LEN];
+static uint8_t                TC_Encoded[2 * TC_BIG_FRAME_LEN + 8];
+static uint8_t                TC_ArenaStorage[8192];
+static size_t                 TC_GrowCnt;
+
+void setUp(void)
+{
+  STX_ETX_CRC16_GetConfig(STX_ETX_CRC16_XMODEM, &TC_ConfigCRC);
+
+  for (size_t i = 0; i < sizeof(TC_Payload); i++)
+  {
+    TC_Payload[i] = (uint8_t)(i * 7 + (i >> 8));
+  }
+  TC_GrowCnt = 0;
+}
+
+void tearDown(void)
+{
+
+}
+
+static uint8_t * TC_Grow(void * p_context, uint8_t * p_data, size_t len, size_t min_len, size_t * p_capacity)
+{
+  (void)p_context;
+  (void)len;
+
+  TC_GrowCnt++;
+  *p_capacity = min_len;
+  return realloc(p_data, min_len);
+}
+
+static size_t TC_Encode(STX_ETX_Config_t const * p_config, uint8_t const * p_data, size_t len, uint8_t * p_out)
+{
+  STX_ETX_t stx_etx;
+  size_t    out_len = sizeof(TC_Encoded);
+
+  STX_ETX_Init(&stx_etx, p_config);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Encode(&stx_etx, p_data, &len, p_out, &out_len));
+  return out_len;
+}
+
+void test_DecodeAllocGrowth(void)
+{
+  const STX_ETX_Allocator_t allocator = {TC_Grow, NULL, NULL};
+
+  STX_ETX_t        stx_etx;
+  STX_ETX_Buffer_t buffer      = {0};
+  size_t           encoded_len = TC_Encode(&TC_ConfigCRC, TC_Payload, sizeof(TC_Payload), TC_Encoded);
+
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+
+  /* Frame is decoded by single call, capacity is doubled. */
+  size_t           in_len = encoded_len;
+  STX_ETX_Status_t status = STX_ETX_DecodeAlloc(&stx_etx, TC_Encoded, &in_len, &buffer, &allocator);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(encoded_len, in_len);
+  TEST_ASSERT_EQUAL(sizeof(TC_Payload), buffer.len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(TC_Payload, buffer.p_data, sizeof(TC_Payload));
+  TEST_ASSERT_EQUAL(1 + 14, TC_GrowCnt);
+
+  free(buffer.p_data);
+}
+
+void test_DecodeAllocArena(void)
+{
+  STX_ETX_Arena_t     arena;
+  STX_ETX_Allocator_t allocator;
+  STX_ETX_t           stx_etx;
+  STX_ETX_Buffer_t    buffer      = {0};
+  const size_t        frame_lens[] = {16, 5000, 100};
+  size_t              encoded_len = 0;
+
+  STX_ETX_Arena_Init(&arena, TC_ArenaStorage, sizeof(TC_ArenaStorage));
+  STX_ETX_Arena_GetAllocator(&arena, &allocator);
+  STX_ETX_Init(&stx_etx, &TC_ConfigNoCRC);
+
+  for (size_t i = 0; i < sizeof(frame_lens) / sizeof(frame_lens[0]); i++)
+  {
+    encoded_len += TC_Encode(&TC_ConfigNoCRC, &TC_Payload[i], frame_lens[i], &TC_Encoded[encoded_len]);
+  }
+
+  /* Frames are decoded in chunks and placed back-to-back in arena. */
+  size_t in_index = 0;
+  size_t frame    = 0;
+
+  while (in_index < encoded_len)
+  {
+    size_t           in_len = (encoded_len - in_index < 1000) ? (encoded_len - in_index) : 1000;
+    STX_ETX_Status_t status = STX_ETX_DecodeAlloc(&stx_etx, &TC_Encoded[in_index], &in_len, &buffer, &allocator);
+
+    in_index += in_len;
+
+    if (STX_ETX_STATUS_DONE == status)
+    {
+      TEST_ASSERT_EQUAL(frame_lens[frame], buffer.len);
+      TEST_ASSERT_EQUAL_HEX8_ARRAY(&TC_Payload[frame], buffer.p_data, buffer.len);
+      TEST_ASSERT_EQUAL_PTR(&TC_ArenaStorage[arena.used], buffer.p_data + buffer.len);
+
+      memset(&buffer, 0, sizeof(buffer));
+      frame++;
+    }
+    else
+    {
+      TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, status);
+    }
+  }
+
+  TEST_ASSERT_EQUAL(3, frame);
+  TEST_ASSERT_EQUAL(16 + 5000 + 100, arena.used);
+}
+
+void test_DecodeAllocLimits(void)
+{
+  const STX_ETX_Allocator_t allocator = {TC_Grow, NULL, NULL};
+
+  STX_ETX_Config_t    config = TC_ConfigNoCRC;
+  STX_ETX_Arena_t     arena;
+  STX_ETX_Allocator_t arena_allocator;
+  STX_ETX_t           stx_etx;
+  STX_ETX_Buffer_t    buffer = {0};
+  size_t              encoded_len = TC_Encode(&TC_ConfigNoCRC, TC_Payload, 300, TC_Encoded);
+
+  /* Capacity is not grown above maximal frame length. */
+  config.max_frame_len = 100;
+  STX_ETX_Init(&stx_etx, &config);
+
+  size_t           in_len = encoded_len;
+  STX_ETX_Status_t status = STX_ETX_DecodeAlloc(&stx_etx, TC_Encoded, &in_len, &buffer, &allocator);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_TOO_LONG, status);
+  TEST_ASSERT_EQUAL(0, buffer.len);
+  TEST_ASSERT_EQUAL(101, buffer.capacity);
+
+  free(buffer.p_data);
+
+  /* Full arena stops decoding, frame is continued, when space is available. */
+  STX_ETX_Arena_Init(&arena, TC_ArenaStorage, 200);
+  STX_ETX_Arena_GetAllocator(&arena, &arena_allocator);
+  STX_ETX_Init(&stx_etx, &TC_ConfigNoCRC);
+  memset(&buffer, 0, sizeof(buffer));
+
+  in_len = encoded_len;
+  status = STX_ETX_DecodeAlloc(&stx_etx, TC_Encoded, &in_len, &buffer, &arena_allocator);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_OVERFLOW, status);
+  TEST_ASSERT_EQUAL(200, buffer.len);
+
+  size_t in_offset = in_len;
+
+  arena.size = sizeof(TC_ArenaStorage);
+  in_len     = encoded_len - in_offset;
+  status     = STX_ETX_DecodeAlloc(&stx_etx, &TC_Encoded[in_offset], &in_len, &buffer, &arena_allocator);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(300, buffer.len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(TC_Payload, buffer.p_data, buffer.len);
+}
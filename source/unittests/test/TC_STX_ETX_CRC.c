@@ -0,0 +1,256 @@
+#include <stdio.h>
+
+#include "STX_ETX.h"
+#include "STX_ETX_CRC.h"
+
+#include "unity.h"
+
+
+#define CRC16_POLY 0x8005
+#define CRC16_INIT UINT16_MAX
+
+static const uint8_t TC_CheckInput[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+static STX_ETX_CRC16_Engine_t TC_Engine;
+
+static uint16_t TC_UpdateCrc(uint16_t crc, uint8_t data);
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+static uint16_t TC_UpdateCrc(uint16_t crc, uint8_t data)
+{
+  for (size_t i = 0; i < 8; i++)
+  {
+    if (((crc & 0x8000) >> 8) ^ (data & 0x80))
+    {
+      crc = (crc << 1) ^ CRC16_POLY;
+    }
+    else
+    {
+      crc = (crc << 1);
+    }
+    data <<= 1;
+  }
+  return crc;
+}
+
+static void TC_CheckEngine(STX_ETX_CRC16_Kernel_t kernel)
+{
+  uint8_t data[1031];
+
+  STX_ETX_CRC16_EngineInit(&TC_Engine, CRC16_POLY, false);
+  if (!STX_ETX_CRC16_EngineSetKernel(&TC_Engine, kernel))
+  {
+    return;
+  }
+
+  for (size_t i = 0; i < sizeof(data); i++)
+  {
+    data[i] = (uint8_t)(i * 131 + (i >> 3));
+  }
+
+  for (size_t len = 0; len <= sizeof(data); len += 7)
+  {
+    uint16_t expected_crc16 = CRC16_INIT;
+    for (size_t i = 0; i < len; i++)
+    {
+      expected_crc16 = TC_UpdateCrc(expected_crc16, data[i]);
+    }
+
+    TEST_ASSERT_EQUAL_HEX16(expected_crc16, STX_ETX_CRC16_EngineUpdate(&TC_Engine, CRC16_INIT, data, len));
+  }
+}
+
+static void TC_CheckEngineReflected(STX_ETX_CRC16_Kernel_t kernel)
+{
+  STX_ETX_Config_t config;
+  uint8_t          data[1031];
+
+  TEST_ASSERT_TRUE(STX_ETX_CRC16_GetConfig(STX_ETX_CRC16_MODBUS, &config));
+
+  STX_ETX_CRC16_EngineInit(&TC_Engine, CRC16_POLY, true);
+  if (!STX_ETX_CRC16_EngineSetKernel(&TC_Engine, kernel))
+  {
+    return;
+  }
+
+  for (size_t i = 0; i < sizeof(data); i++)
+  {
+    data[i] = (uint8_t)(i * 29 + (i >> 5));
+  }
+
+  for (size_t len = 0; len <= sizeof(data); len += 7)
+  {
+    TEST_ASSERT_EQUAL_HEX16(config.update_crc16_block(config.initial_crc16, data, len),
+                            STX_ETX_CRC16_EngineUpdate(&TC_Engine, config.initial_crc16, data, len));
+  }
+}
+
+static void TC_CheckPreset(STX_ETX_CRC16_Preset_t preset, uint16_t expected_check)
+{
+  STX_ETX_Config_t config;
+
+  TEST_ASSERT_TRUE(STX_ETX_CRC16_GetConfig(preset, &config));
+
+  uint16_t crc16 = config.initial_crc16;
+  for (size_t i = 0; i < sizeof(TC_CheckInput); i++)
+  {
+    crc16 = config.update_crc16(crc16, TC_CheckInput[i]);
+  }
+  TEST_ASSERT_EQUAL_HEX16(expected_check, crc16);
+
+  crc16 = config.update_crc16_block(config.initial_crc16, TC_CheckInput, sizeof(TC_CheckInput));
+  TEST_ASSERT_EQUAL_HEX16(expected_check, crc16);
+}
+
+static void TC_CheckBlock(STX_ETX_CRC16_Preset_t preset)
+{
+  STX_ETX_Config_t config;
+  uint8_t          data[67];
+
+  TEST_ASSERT_TRUE(STX_ETX_CRC16_GetConfig(preset, &config));
+
+  for (size_t i = 0; i < sizeof(data); i++)
+  {
+    data[i] = (uint8_t)(i * 37 + 11);
+  }
+
+  for (size_t len = 0; len <= sizeof(data); len++)
+  {
+    uint16_t expected_crc16 = config.initial_crc16;
+    for (size_t i = 0; i < len; i++)
+    {
+      expected_crc16 = config.update_crc16(expected_crc16, data[i]);
+    }
+
+    TEST_ASSERT_EQUAL_HEX16(expected_crc16, config.update_crc16_block(config.initial_crc16, data, len));
+  }
+}
+
+
+void test_CheckARC(void)
+{
+  TC_CheckPreset(STX_ETX_CRC16_ARC, 0xBB3D);
+}
+
+void test_CheckCCITTFalse(void)
+{
+  TC_CheckPreset(STX_ETX_CRC16_CCITT_FALSE, 0x29B1);
+}
+
+void test_CheckMODBUS(void)
+{
+  TC_CheckPreset(STX_ETX_CRC16_MODBUS, 0x4B37);
+}
+
+void test_CheckXMODEM(void)
+{
+  TC_CheckPreset(STX_ETX_CRC16_XMODEM, 0x31C3);
+}
+
+void test_BlockMatchesBytes8005Reflected(void)
+{
+  TC_CheckBlock(STX_ETX_CRC16_MODBUS);
+}
+
+void test_BlockMatchesBytes1021(void)
+{
+  TC_CheckBlock(STX_ETX_CRC16_CCITT_FALSE);
+}
+
+void test_UnknownPreset(void)
+{
+  STX_ETX_Config_t config;
+
+  TEST_ASSERT_FALSE(STX_ETX_CRC16_GetConfig(STX_ETX_CRC16_LAST, &config));
+}
+
+void test_BlockOnlyConfig(void)
+{
+  const STX_ETX_Config_t config_byte  = {.initial_crc16 = 0xFFFF, .update_crc16       = STX_ETX_CRC16_Update1021};
+  const STX_ETX_Config_t config_block = {.initial_crc16 = 0xFFFF, .update_crc16_block = STX_ETX_CRC16_UpdateBlock1021};
+
+  const uint8_t decoded[] = {0x00, 0x01, STX, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, ETX, DLE, 0x30};
+  uint8_t       encoded_byte[2 * sizeof(decoded) + 4];
+  uint8_t       encoded_block[2 * sizeof(decoded) + 4];
+  uint8_t       redecoded[sizeof(decoded)];
+
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &config_byte);
+
+  size_t decoded_len      = sizeof(decoded);
+  size_t encoded_byte_len = sizeof(encoded_byte);
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_DONE, STX_ETX_Encode(&stx_etx, decoded, &decoded_len, encoded_byte, &encoded_byte_len));
+
+  STX_ETX_Init(&stx_etx, &config_block);
+
+  decoded_len              = sizeof(decoded);
+  size_t encoded_block_len = sizeof(encoded_block);
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_DONE, STX_ETX_Encode(&stx_etx, decoded, &decoded_len, encoded_block, &encoded_block_len));
+
+  TEST_ASSERT_EQUAL(encoded_byte_len, encoded_block_len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(encoded_byte, encoded_block, encoded_byte_len);
+
+  size_t redecoded_len = sizeof(redecoded);
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_DONE, STX_ETX_Decode(&stx_etx, encoded_block, &encoded_block_len, redecoded, &redecoded_len));
+  TEST_ASSERT_EQUAL(sizeof(decoded), redecoded_len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(decoded, redecoded, redecoded_len);
+}
+
+void test_EngineTable(void)
+{
+  TC_CheckEngine(STX_ETX_CRC16_KERNEL_TABLE);
+}
+
+void test_EngineClmul(void)
+{
+  TC_CheckEngine(STX_ETX_CRC16_KERNEL_CLMUL);
+}
+
+void test_EnginePmull(void)
+{
+  TC_CheckEngine(STX_ETX_CRC16_KERNEL_PMULL);
+}
+
+void test_EngineReflectedTable(void)
+{
+  TC_CheckEngineReflected(STX_ETX_CRC16_KERNEL_TABLE);
+}
+
+void test_EngineReflectedClmul(void)
+{
+  TC_CheckEngineReflected(STX_ETX_CRC16_KERNEL_CLMUL);
+}
+
+void test_EngineReflectedPmull(void)
+{
+  TC_CheckEngineReflected(STX_ETX_CRC16_KERNEL_PMULL);
+}
+
+void test_EngineConfig(void)
+{
+  const uint8_t expected_encoded[] = {STX, 0x00, 0x01, DLE, ETX, ETX, 0x91, 0x6F};
+  const uint8_t expected_decoded[] = {0x00, 0x01, ETX};
+  uint8_t       decoded[sizeof(expected_decoded)];
+
+  STX_ETX_CRC16_EngineInit(&TC_Engine, CRC16_POLY, false);
+
+  const STX_ETX_Config_t config = {.initial_crc16 = CRC16_INIT, .p_crc16_engine = &TC_Engine};
+
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &config);
+
+  size_t encoded_len = sizeof(expected_encoded);
+  size_t decoded_len = sizeof(decoded);
+  TEST_ASSERT_EQUAL(STX_ETX_STATUS_DONE, STX_ETX_Decode(&stx_etx, expected_encoded, &encoded_len, decoded, &decoded_len));
+  TEST_ASSERT_EQUAL(sizeof(expected_decoded), decoded_len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_decoded, decoded, decoded_len);
+}
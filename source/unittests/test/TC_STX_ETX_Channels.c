@@ -0,0 +1,206 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "STX_ETX.h"
+#include "STX_ETX_CRC.h"
+#include "STX_ETX_Channels.h"
+
+#include "unity.h"
+
+
+#define TC_CHANNELS_CNT 4
+
+static STX_ETX_Config_t   TC_Configs[2];
+static STX_ETX_Channels_t TC_Channels;
+static uint32_t           TC_Storage[STX_ETX_CHANNELS_STORAGE_SIZE(TC_CHANNELS_CNT) / sizeof(uint32_t)];
+
+void setUp(void)
+{
+  memset(&TC_Configs[0], 0, sizeof(TC_Configs[0]));
+  STX_ETX_CRC16_GetConfig(STX_ETX_CRC16_XMODEM, &TC_Configs[1]);
+
+  STX_ETX_Channels_Init(&TC_Channels, TC_Storage, TC_CHANNELS_CNT, TC_Configs);
+  STX_ETX_Channels_Setup(&TC_Channels, 1, 1);
+}
+
+void tearDown(void)
+{
+
+}
+
+static size_t TC_Encode(STX_ETX_Config_t const * p_config,
+                        uint8_t const *          p_in,
+                        size_t                   in_len,
+                        uint8_t *                p_out,
+                        size_t                   out_len)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, p_config);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Encode(&stx_etx, p_in, &in_len, p_out, &out_len));
+  return out_len;
+}
+
+void test_InterleavedChannels(void)
+{
+  const uint8_t data0[] = {0x00, STX, 0x01, 0x02};
+  const uint8_t data1[] = {0x10, 0x11, ETX, DLE, 0x12};
+
+  uint8_t encoded0[16];
+  uint8_t encoded1[16];
+  size_t  encoded0_len = TC_Encode(&TC_Configs[0], data0, sizeof(data0), encoded0, sizeof(encoded0));
+  size_t  encoded1_len = TC_Encode(&TC_Configs[1], data1, sizeof(data1), encoded1, sizeof(encoded1));
+
+  const STX_ETX_Chunk_t chunks[] =
+  {
+    {0, encoded0,     3},
+    {1, encoded1,     4},
+    {0, &encoded0[3], encoded0_len - 3},
+    {1, &encoded1[4], encoded1_len - 4},
+  };
+
+  uint8_t                decoded[32];
+  STX_ETX_ChannelFrame_t frames[8];
+
+  size_t           chunks_cnt  = sizeof(chunks) / sizeof(chunks[0]);
+  size_t           in_offset   = 0;
+  size_t           decoded_len = sizeof(decoded);
+  size_t           frames_cnt  = sizeof(frames) / sizeof(frames[0]);
+  STX_ETX_Status_t status      = STX_ETX_Channels_DecodeBatch(&TC_Channels,
+                                                              chunks,
+                                                              &chunks_cnt,
+                                                              &in_offset,
+                                                              decoded,
+                                                              &decoded_len,
+                                                              frames,
+                                                              &frames_cnt);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(4, chunks_cnt);
+  TEST_ASSERT_EQUAL(0, in_offset);
+  TEST_ASSERT_EQUAL(sizeof(data0) + sizeof(data1), decoded_len);
+  TEST_ASSERT_EQUAL(4, frames_cnt);
+
+  TEST_ASSERT_EQUAL(0, frames[0].channel_id);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, frames[0].frame.status);
+  TEST_ASSERT_EQUAL(1, frames[1].channel_id);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, frames[1].frame.status);
+  TEST_ASSERT_EQUAL(0, frames[2].channel_id);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, frames[2].frame.status);
+  TEST_ASSERT_EQUAL(1, frames[3].channel_id);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, frames[3].frame.status);
+
+  uint8_t decoded0[sizeof(data0)];
+  uint8_t decoded1[sizeof(data1)];
+
+  TEST_ASSERT_EQUAL(sizeof(data0), frames[0].frame.len + frames[2].frame.len);
+  memcpy(decoded0, &decoded[frames[0].frame.offset], frames[0].frame.len);
+  memcpy(&decoded0[frames[0].frame.len], &decoded[frames[2].frame.offset], frames[2].frame.len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(data0, decoded0, sizeof(data0));
+
+  TEST_ASSERT_EQUAL(sizeof(data1), frames[1].frame.len + frames[3].frame.len);
+  memcpy(decoded1, &decoded[frames[1].frame.offset], frames[1].frame.len);
+  memcpy(&decoded1[frames[1].frame.len], &decoded[frames[3].frame.offset], frames[3].frame.len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(data1, decoded1, sizeof(data1));
+}
+
+void test_InvalidCRCChannel(void)
+{
+  const uint8_t data[] = {0x20, 0x21, 0x22};
+
+  uint8_t encoded[16];
+  size_t  encoded_len = TC_Encode(&TC_Configs[1], data, sizeof(data), encoded, sizeof(encoded));
+
+  encoded[encoded_len - 1] ^= 0xFF;
+
+  const STX_ETX_Chunk_t chunks[] =
+  {
+    {1, encoded, encoded_len},
+    {2, encoded, encoded_len},
+  };
+
+  uint8_t                decoded[32];
+  STX_ETX_ChannelFrame_t frames[8];
+
+  size_t           chunks_cnt  = sizeof(chunks) / sizeof(chunks[0]);
+  size_t           in_offset   = 0;
+  size_t           decoded_len = sizeof(decoded);
+  size_t           frames_cnt  = sizeof(frames) / sizeof(frames[0]);
+  STX_ETX_Status_t status      = STX_ETX_Channels_DecodeBatch(&TC_Channels,
+                                                              chunks,
+                                                              &chunks_cnt,
+                                                              &in_offset,
+                                                              decoded,
+                                                              &decoded_len,
+                                                              frames,
+                                                              &frames_cnt);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(4, frames_cnt);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_INV_CRC, frames[0].frame.status);
+  TEST_ASSERT_EQUAL(0, frames[0].frame.len);
+
+  /* Channel 2 has no CRC, so the CRC bytes are invalid characters after ETX. */
+  TEST_ASSERT_EQUAL(2, frames[1].channel_id);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, frames[1].frame.status);
+  TEST_ASSERT_EQUAL(sizeof(data), frames[1].frame.len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(data, &decoded[frames[1].frame.offset], sizeof(data));
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_INV_CHAR, frames[2].frame.status);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_INV_CHAR, frames[3].frame.status);
+}
+
+void test_FramesExhausted(void)
+{
+  const uint8_t data[] = {0x30, ETX, 0x31};
+
+  uint8_t encoded[32];
+  size_t  encoded_len = TC_Encode(&TC_Configs[0], data, sizeof(data), encoded, sizeof(encoded));
+
+  memcpy(&encoded[encoded_len], encoded, encoded_len);
+
+  const STX_ETX_Chunk_t chunks[] =
+  {
+    {3, encoded, 2 * encoded_len},
+  };
+
+  uint8_t                decoded[32];
+  STX_ETX_ChannelFrame_t frames[1];
+
+  size_t           chunks_cnt  = 1;
+  size_t           in_offset   = 0;
+  size_t           decoded_len = sizeof(decoded);
+  size_t           frames_cnt  = 1;
+  STX_ETX_Status_t status      = STX_ETX_Channels_DecodeBatch(&TC_Channels,
+                                                              chunks,
+                                                              &chunks_cnt,
+                                                              &in_offset,
+                                                              decoded,
+                                                              &decoded_len,
+                                                              frames,
+                                                              &frames_cnt);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_OVERFLOW, status);
+  TEST_ASSERT_EQUAL(0, chunks_cnt);
+  TEST_ASSERT_EQUAL(encoded_len, in_offset);
+  TEST_ASSERT_EQUAL(1, frames_cnt);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, frames[0].frame.status);
+
+  chunks_cnt  = 1;
+  decoded_len = sizeof(decoded);
+  frames_cnt  = 1;
+  status      = STX_ETX_Channels_DecodeBatch(&TC_Channels,
+                                             chunks,
+                                             &chunks_cnt,
+                                             &in_offset,
+                                             decoded,
+                                             &decoded_len,
+                                             frames,
+                                             &frames_cnt);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(1, chunks_cnt);
+  TEST_ASSERT_EQUAL(0, in_offset);
+  TEST_ASSERT_EQUAL(sizeof(data), decoded_len);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, frames[0].frame.status);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(data, decoded, sizeof(data));
+}
@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "STX_ETX.h"
+#include "STX_ETX_CRC.h"
+#include "STX_ETX_Codec.h"
+
+#include "unity.h"
+
+
+#define TC_STREAM_LEN  8192
+
+STX_ETX_DEFINE_CODEC(TC_Xmodem, STX_ETX_CRC16_UpdateBlock1021, 0)
+STX_ETX_DEFINE_CODEC_NO_CRC(TC_Plain)
+STX_ETX_DEFINE_CODEC_PAYLOAD_CRC(TC_XmodemPayload, STX_ETX_CRC16_UpdateBlock1021, 0)
+
+static uint8_t TC_Stream[TC_STREAM_LEN];
+static size_t  TC_StreamLen;
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+static uint32_t TC_Random(uint32_t * p_seed)
+{
+  *p_seed = *p_seed * 1103515245u + 12345u;
+  return *p_seed >> 8;
+}
+
+static void TC_BuildStream(STX_ETX_Config_t const * p_config, uint32_t seed)
+{
+  uint8_t payload[300];
+
+  TC_StreamLen = 0;
+
+  while (TC_StreamLen + 2 * sizeof(payload) + 8 < sizeof(TC_Stream))
+  {
+    size_t payload_len = TC_Random(&seed) % sizeof(payload);
+
+    for (size_t i = 0; i < payload_len; i++)
+    {
+      payload[i] = (uint8_t)TC_Random(&seed);
+
+      if (0 == (payload[i] & 0x0F))
+      {
+        payload[i] = (uint8_t[]){STX, ETX, DLE}[payload[i] % 3];
+      }
+    }
+
+    STX_ETX_t stx_etx;
+    STX_ETX_Init(&stx_etx, p_config);
+
+    size_t in_len  = payload_len;
+    size_t out_len = sizeof(TC_Stream) - TC_StreamLen;
+    STX_ETX_Encode(&stx_etx, payload, &in_len, &TC_Stream[TC_StreamLen], &out_len);
+
+    /* Corrupt some frames and add some garbage. */
+    if (0 == (TC_Random(&seed) % 8))
+    {
+      TC_Stream[TC_StreamLen + TC_Random(&seed) % out_len] ^= (uint8_t)(1u << (TC_Random(&seed) % 8));
+    }
+    TC_StreamLen += out_len;
+
+    if (0 == (TC_Random(&seed) % 8))
+    {
+      TC_Stream[TC_StreamLen++] = (uint8_t)TC_Random(&seed);
+    }
+  }
+}
+
+static bool TC_IsCRC(STX_ETX_Config_t const * p_config)
+{
+  return (NULL != p_config->update_crc16) || (NULL != p_config->update_crc16_block) || (NULL != p_config->p_crc16_engine);
+}
+
+static void TC_CompareDecode(STX_ETX_Config_t const * p_config,
+                             STX_ETX_Status_t (*p_decode)(STX_ETX_t *, uint8_t const *, size_t *, uint8_t *, size_t *),
+                             uint32_t                 seed)
+{
+  STX_ETX_t generic;
+  STX_ETX_t codec;
+  uint8_t   generic_out[64];
+  uint8_t   codec_out[64];
+  size_t    in_index = 0;
+
+  TC_BuildStream(p_config, seed);
+  STX_ETX_Init(&generic, p_config);
+  STX_ETX_Init(&codec, p_config);
+
+  while (in_index < TC_StreamLen)
+  {
+    size_t in_len      = 1 + TC_Random(&seed) % 80;
+    size_t out_len     = TC_Random(&seed) % sizeof(generic_out);
+    size_t generic_in  = (in_len < TC_StreamLen - in_index) ? in_len : (TC_StreamLen - in_index);
+    size_t codec_in    = generic_in;
+    size_t generic_len = out_len;
+    size_t codec_len   = out_len;
+
+    STX_ETX_Status_t generic_status = STX_ETX_Decode(&generic, &TC_Stream[in_index], &generic_in, generic_out, &generic_len);
+    STX_ETX_Status_t codec_status   = p_decode(&codec, &TC_Stream[in_index], &codec_in, codec_out, &codec_len);
+
+    TEST_ASSERT_EQUAL_HEX8(generic_status, codec_status);
+    TEST_ASSERT_EQUAL(generic_in, codec_in);
+    TEST_ASSERT_EQUAL(generic_len, codec_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(generic_out, codec_out, generic_len);
+    TEST_ASSERT_EQUAL(generic.state, codec.state);
+
+    /* Computed CRC is not initialized without CRC. */
+    if (TC_IsCRC(p_config))
+    {
+      TEST_ASSERT_EQUAL_HEX16(generic.computed_crc16, codec.computed_crc16);
+    }
+
+    in_index += generic_in;
+  }
+}
+
+static void TC_CompareEncode(STX_ETX_Config_t const * p_config,
+                             STX_ETX_Status_t (*p_encode)(STX_ETX_t *, uint8_t const *, size_t *, uint8_t *, size_t *),
+                             uint32_t                 seed)
+{
+  STX_ETX_t generic;
+  STX_ETX_t codec;
+  uint8_t   payload[200];
+  uint8_t   generic_out[16];
+  uint8_t   codec_out[16];
+
+  STX_ETX_Init(&generic, p_config);
+  STX_ETX_Init(&codec, p_config);
+
+  for (size_t frame = 0; frame < 100; frame++)
+  {
+    size_t           payload_len = TC_Random(&seed) % sizeof(payload);
+    size_t           in_index    = 0;
+    STX_ETX_Status_t status      = STX_ETX_STATUS_CONTINUE;
+
+    for (size_t i = 0; i < payload_len; i++)
+    {
+      payload[i] = (uint8_t)TC_Random(&seed);
+
+      if (0 == (payload[i] & 0x07))
+      {
+        payload[i] = (uint8_t[]){STX, ETX, DLE}[payload[i] % 3];
+      }
+    }
+
+    while (STX_ETX_STATUS_DONE != status)
+    {
+      size_t out_len     = TC_Random(&seed) % sizeof(generic_out);
+      size_t generic_in  = payload_len - in_index;
+      size_t codec_in    = generic_in;
+      size_t generic_len = out_len;
+      size_t codec_len   = out_len;
+
+      status = STX_ETX_Encode(&generic, &payload[in_index], &generic_in, generic_out, &generic_len);
+
+      TEST_ASSERT_EQUAL_HEX8(status, p_encode(&codec, &payload[in_index], &codec_in, codec_out, &codec_len));
+      TEST_ASSERT_EQUAL(generic_in, codec_in);
+      TEST_ASSERT_EQUAL(generic_len, codec_len);
+      TEST_ASSERT_EQUAL_HEX8_ARRAY(generic_out, codec_out, generic_len);
+      TEST_ASSERT_EQUAL(generic.state, codec.state);
+
+      if (TC_IsCRC(p_config))
+      {
+        TEST_ASSERT_EQUAL_HEX16(generic.computed_crc16, codec.computed_crc16);
+      }
+
+      in_index += generic_in;
+    }
+  }
+}
+
+void test_CodecDecodeCRC(void)
+{
+  for (uint32_t seed = 1; seed <= 8; seed++)
+  {
+    TC_CompareDecode(&TC_Xmodem_Config, TC_Xmodem_Decode, seed);
+  }
+}
+
+void test_CodecDecodeNoCRC(void)
+{
+  for (uint32_t seed = 1; seed <= 8; seed++)
+  {
+    TC_CompareDecode(&TC_Plain_Config, TC_Plain_Decode, seed);
+  }
+}
+
+void test_CodecDecodePayloadCRC(void)
+{
+  for (uint32_t seed = 1; seed <= 8; seed++)
+  {
+    TC_CompareDecode(&TC_XmodemPayload_Config, TC_XmodemPayload_Decode, seed);
+  }
+}
+
+void test_CodecEncodeCRC(void)
+{
+  TC_CompareEncode(&TC_Xmodem_Config, TC_Xmodem_Encode, 1);
+}
+
+void test_CodecEncodeNoCRC(void)
+{
+  TC_CompareEncode(&TC_Plain_Config, TC_Plain_Encode, 2);
+}
+
+void test_CodecEncodePayloadCRC(void)
+{
+  TC_CompareEncode(&TC_XmodemPayload_Config, TC_XmodemPayload_Encode, 3);
+}
+
+void test_CodecMatchesPreset(void)
+{
+  STX_ETX_Config_t config;
+  STX_ETX_t        stx_etx;
+
+  STX_ETX_CRC16_GetConfig(STX_ETX_CRC16_XMODEM, &config);
+  STX_ETX_Init(&stx_etx, &config);
+  TC_Xmodem_Init(&stx_etx);
+
+  const uint8_t data[]     = {0x00, STX, 0x01, DLE, ETX};
+  uint8_t       encoded[16];
+  uint8_t       decoded[16];
+  size_t        data_len    = sizeof(data);
+  size_t        encoded_len = sizeof(encoded);
+  size_t        decoded_len = sizeof(decoded);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, TC_Xmodem_Encode(&stx_etx, data, &data_len, encoded, &encoded_len));
+
+  /* Frame encoded by codec is decoded by parser with preset configuration. */
+  STX_ETX_Init(&stx_etx, &config);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Decode(&stx_etx, encoded, &encoded_len, decoded, &decoded_len));
+  TEST_ASSERT_EQUAL(sizeof(data), decoded_len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(data, decoded, decoded_len);
+}
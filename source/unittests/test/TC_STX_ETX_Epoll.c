@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "STX_ETX.h"
+#include "STX_ETX_CRC.h"
+#include "STX_ETX_Epoll.h"
+
+#include "unity.h"
+
+
+#define TC_SOURCES_CNT  2
+#define TC_FRAME_SIZE   64
+#define TC_FRAMES_MAX   512
+
+static STX_ETX_Config_t      TC_Config;
+static STX_ETX_Epoll_t       TC_Epoll;
+static STX_ETX_EpollSource_t TC_Sources[TC_SOURCES_CNT];
+static uint8_t               TC_Frames[TC_SOURCES_CNT][TC_FRAME_SIZE];
+static uint8_t               TC_Buf[256];
+static int                   TC_Fds[TC_SOURCES_CNT][2];
+
+static size_t                TC_FramesCnt[TC_SOURCES_CNT];
+static size_t                TC_FramesLen[TC_SOURCES_CNT];
+static uint8_t               TC_FramesData[TC_SOURCES_CNT][TC_FRAMES_MAX * TC_FRAME_SIZE];
+static size_t                TC_ClosedCnt;
+
+static void TC_OnFrame(void * p_context, STX_ETX_EpollSource_t * p_source, uint8_t const * p_data, size_t len)
+{
+  size_t index = (size_t)(p_source - TC_Sources);
+
+  (void)p_context;
+
+  TC_FramesCnt[index]++;
+  memcpy(&TC_FramesData[index][TC_FramesLen[index]], p_data, len);
+  TC_FramesLen[index] += len;
+}
+
+static void TC_OnClose(void * p_context, STX_ETX_EpollSource_t * p_source)
+{
+  (void)p_context;
+
+  TEST_ASSERT_FALSE(p_source->is_open);
+  TEST_ASSERT_EQUAL(0, p_source->error);
+  TC_ClosedCnt++;
+}
+
+void setUp(void)
+{
+  TEST_ASSERT_TRUE(STX_ETX_CRC16_GetConfig(STX_ETX_CRC16_XMODEM, &TC_Config));
+  TEST_ASSERT_TRUE(STX_ETX_Epoll_Init(&TC_Epoll, TC_Buf, sizeof(TC_Buf), TC_OnFrame, TC_OnClose, NULL));
+
+  memset(TC_FramesCnt, 0, sizeof(TC_FramesCnt));
+  memset(TC_FramesLen, 0, sizeof(TC_FramesLen));
+  TC_ClosedCnt = 0;
+
+  /* Pipe and stream socket pair. */
+  TEST_ASSERT_EQUAL(0, pipe(TC_Fds[0]));
+  TEST_ASSERT_EQUAL(0, socketpair(AF_UNIX, SOCK_STREAM, 0, TC_Fds[1]));
+
+  for (size_t i = 0; i < TC_SOURCES_CNT; i++)
+  {
+    TEST_ASSERT_TRUE(STX_ETX_Epoll_Add(&TC_Epoll, &TC_Sources[i], TC_Fds[i][0], &TC_Config, TC_Frames[i], TC_FRAME_SIZE));
+  }
+}
+
+void tearDown(void)
+{
+  STX_ETX_Epoll_Close(&TC_Epoll);
+
+  for (size_t i = 0; i < TC_SOURCES_CNT; i++)
+  {
+    close(TC_Fds[i][0]);
+
+    if (TC_Fds[i][1] >= 0)
+    {
+      close(TC_Fds[i][1]);
+    }
+  }
+}
+
+static size_t TC_EncodeFrame(uint8_t const * p_payload, size_t payload_len, uint8_t * p_out, size_t out_len)
+{
+  STX_ETX_t stx_etx;
+
+  STX_ETX_Init(&stx_etx, &TC_Config);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Encode(&stx_etx, p_payload, &payload_len, p_out, &out_len));
+  return out_len;
+}
+
+static void TC_Write(size_t index, uint8_t const * p_data, size_t len)
+{
+  TEST_ASSERT_EQUAL(len, write(TC_Fds[index][1], p_data, len));
+}
+
+static void TC_RunUntilIdle(void)
+{
+  while (STX_ETX_Epoll_Run(&TC_Epoll, 0) > 0)
+  {
+  }
+}
+
+void test_EpollSplitFrames(void)
+{
+  const uint8_t payload[] = {0x01, STX, 0x20, ETX, DLE, 0x30};
+  uint8_t       encoded[2 * sizeof(payload) + 8];
+  size_t        encoded_len = TC_EncodeFrame(payload, sizeof(payload), encoded, sizeof(encoded));
+
+  /* Frame split between writes is continued by the next run. */
+  TC_Write(0, encoded, 2);
+  TC_Write(1, encoded, encoded_len - 1);
+  TC_RunUntilIdle();
+
+  TEST_ASSERT_EQUAL(0, TC_FramesCnt[0]);
+  TEST_ASSERT_EQUAL(0, TC_FramesCnt[1]);
+  TEST_ASSERT_EQUAL(1, TC_Sources[0].source.frame_len);
+
+  TC_Write(0, &encoded[2], encoded_len - 2);
+  TC_Write(1, &encoded[encoded_len - 1], 1);
+  TEST_ASSERT_EQUAL(2, STX_ETX_Epoll_Run(&TC_Epoll, 1000));
+
+  for (size_t i = 0; i < TC_SOURCES_CNT; i++)
+  {
+    TEST_ASSERT_EQUAL(1, TC_FramesCnt[i]);
+    TEST_ASSERT_EQUAL(sizeof(payload), TC_FramesLen[i]);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(payload, TC_FramesData[i], sizeof(payload));
+  }
+
+}
+
+void test_EpollDrain(void)
+{
+  uint8_t stream[TC_FRAMES_MAX * (2 * TC_FRAME_SIZE + 8)];
+  uint8_t payload[2 * TC_FRAME_SIZE];
+  uint8_t expected[TC_FRAMES_MAX * TC_FRAME_SIZE];
+  size_t  stream_len   = 0;
+  size_t  expected_len = 0;
+  size_t  frames_cnt   = 0;
+
+  /* Stream is many times larger than read buffer, every 16th frame does not fit frame buffer. */
+  for (size_t index = 0; index < 200; index++)
+  {
+    size_t payload_len = (0 == (index % 16)) ? sizeof(payload) : (index % TC_FRAME_SIZE);
+
+    for (size_t i = 0; i < payload_len; i++)
+    {
+      payload[i] = (uint8_t)(index * 7 + i);
+    }
+
+    stream_len += TC_EncodeFrame(payload, payload_len, &stream[stream_len], sizeof(stream) - stream_len);
+
+    if (payload_len <= TC_FRAME_SIZE)
+    {
+      memcpy(&expected[expected_len], payload, payload_len);
+      expected_len += payload_len;
+      frames_cnt++;
+    }
+  }
+
+  TEST_ASSERT_TRUE(stream_len > STX_ETX_EPOLL_READS_MAX * sizeof(TC_Buf));
+  TC_Write(1, stream, stream_len);
+
+  /* Busy source is read in limited portions, it stays ready without new edge. */
+  TEST_ASSERT_EQUAL(1, STX_ETX_Epoll_Run(&TC_Epoll, 1000));
+  TEST_ASSERT_TRUE(TC_Sources[1].is_ready);
+  TEST_ASSERT_TRUE(TC_FramesCnt[1] < frames_cnt);
+
+  TC_RunUntilIdle();
+
+  TEST_ASSERT_FALSE(TC_Sources[1].is_ready);
+  TEST_ASSERT_EQUAL(frames_cnt, TC_FramesCnt[1]);
+  TEST_ASSERT_EQUAL(expected_len, TC_FramesLen[1]);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, TC_FramesData[1], expected_len);
+  TEST_ASSERT_EQUAL(200 - frames_cnt, TC_Sources[1].source.resync.too_long_cnt);
+  TEST_ASSERT_EQUAL(0, TC_FramesCnt[0]);
+}
+
+void test_EpollClose(void)
+{
+  const uint8_t payload[] = {0x11, 0x22};
+  uint8_t       encoded[2 * sizeof(payload) + 8];
+  size_t        encoded_len = TC_EncodeFrame(payload, sizeof(payload), encoded, sizeof(encoded));
+
+  /* Frame written before end of file is delivered, then source is closed. */
+  TC_Write(0, encoded, encoded_len);
+  close(TC_Fds[0][1]);
+  TC_Fds[0][1] = -1;
+  TC_RunUntilIdle();
+
+  TEST_ASSERT_EQUAL(1, TC_FramesCnt[0]);
+  TEST_ASSERT_EQUAL(1, TC_ClosedCnt);
+  TEST_ASSERT_FALSE(TC_Sources[0].is_open);
+
+  /* Other source still works, after it is removed nothing is read. */
+  TC_Write(1, encoded, encoded_len);
+  TC_RunUntilIdle();
+  TEST_ASSERT_EQUAL(1, TC_FramesCnt[1]);
+
+  STX_ETX_Epoll_Remove(&TC_Epoll, &TC_Sources[1]);
+  TC_Write(1, encoded, encoded_len);
+  TEST_ASSERT_EQUAL(0, STX_ETX_Epoll_Run(&TC_Epoll, 10));
+  TEST_ASSERT_EQUAL(1, TC_FramesCnt[1]);
+  TEST_ASSERT_EQUAL(1, TC_ClosedCnt);
+}
@@ -0,0 +1,204 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "STX_ETX.h"
+#include "STX_ETX_CRC.h"
+#include "STX_ETX_Parallel.h"
+
+#include "unity.h"
+
+
+#define TC_THREADS_CNT  4
+#define TC_STREAM_LEN   (4 * TC_THREADS_CNT * STX_ETX_PARALLEL_MIN_CHUNK_LEN)
+#define TC_FRAMES_CNT   (TC_STREAM_LEN / 8)
+
+static STX_ETX_Config_t TC_Config;
+
+static uint8_t          TC_Stream[TC_STREAM_LEN];
+static size_t           TC_StreamLen;
+static uint8_t          TC_Decoded[2][TC_STREAM_LEN];
+static STX_ETX_Frame_t  TC_Frames[2][TC_FRAMES_CNT];
+
+void setUp(void)
+{
+  STX_ETX_CRC16_GetConfig(STX_ETX_CRC16_XMODEM, &TC_Config);
+}
+
+void tearDown(void)
+{
+
+}
+
+static void TC_BuildStream(uint32_t seed)
+{
+  uint8_t payload[600];
+
+  TC_StreamLen = 0;
+
+  while (TC_StreamLen + 2 * sizeof(payload) + 8 < sizeof(TC_Stream))
+  {
+    seed = seed * 1103515245u + 12345u;
+
+    size_t payload_len = (seed >> 8) % sizeof(payload);
+
+    for (size_t i = 0; i < payload_len; i++)
+    {
+      seed       = seed * 1103515245u + 12345u;
+      payload[i] = (uint8_t)(seed >> 16);
+
+      /* Frequent special characters make splits inside of frames likely. */
+      if (0 == (payload[i] & 0x0F))
+      {
+        payload[i] = (uint8_t[]){STX, ETX, DLE}[payload[i] % 3];
+      }
+    }
+
+    STX_ETX_t stx_etx;
+    STX_ETX_Init(&stx_etx, &TC_Config);
+
+    size_t in_len  = payload_len;
+    size_t out_len = sizeof(TC_Stream) - TC_StreamLen;
+    STX_ETX_Encode(&stx_etx, payload, &in_len, &TC_Stream[TC_StreamLen], &out_len);
+
+    /* Corrupt some frames and add some garbage. */
+    if (0 == (seed & 0x1F00))
+    {
+      TC_Stream[TC_StreamLen + (seed >> 20) % out_len] ^= 0x01;
+    }
+    TC_StreamLen += out_len;
+
+    if (0 == (seed & 0x3000))
+    {
+      TC_Stream[TC_StreamLen++] = (uint8_t)seed;
+    }
+  }
+
+  /* Stream ends in the middle of a frame. */
+  TC_Stream[TC_StreamLen++] = STX;
+  TC_Stream[TC_StreamLen++] = 0x55;
+}
+
+static STX_ETX_Status_t TC_CompareWithBatch(size_t frames_cnt)
+{
+  STX_ETX_t stx_etx[2];
+  STX_ETX_Init(&stx_etx[0], &TC_Config);
+  STX_ETX_Init(&stx_etx[1], &TC_Config);
+
+  size_t           in_len[2]     = {TC_StreamLen, TC_StreamLen};
+  size_t           out_len[2]    = {TC_StreamLen, TC_StreamLen};
+  size_t           frames_len[2] = {frames_cnt, frames_cnt};
+  STX_ETX_Status_t status[2];
+
+  status[0] = STX_ETX_DecodeBatch(&stx_etx[0],
+                                  TC_Stream,
+                                  &in_len[0],
+                                  TC_Decoded[0],
+                                  &out_len[0],
+                                  TC_Frames[0],
+                                  &frames_len[0]);
+  status[1] = STX_ETX_DecodeParallel(&stx_etx[1],
+                                     TC_Stream,
+                                     &in_len[1],
+                                     TC_Decoded[1],
+                                     &out_len[1],
+                                     TC_Frames[1],
+                                     &frames_len[1],
+                                     TC_THREADS_CNT);
+
+  TEST_ASSERT_EQUAL_HEX8(status[0], status[1]);
+  TEST_ASSERT_EQUAL(in_len[0], in_len[1]);
+  TEST_ASSERT_EQUAL(out_len[0], out_len[1]);
+  TEST_ASSERT_EQUAL(frames_len[0], frames_len[1]);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(TC_Decoded[0], TC_Decoded[1], out_len[0]);
+  TEST_ASSERT_EQUAL_MEMORY(TC_Frames[0], TC_Frames[1], frames_len[0] * sizeof(STX_ETX_Frame_t));
+  TEST_ASSERT_EQUAL(stx_etx[0].state, stx_etx[1].state);
+  TEST_ASSERT_EQUAL_HEX16(stx_etx[0].computed_crc16, stx_etx[1].computed_crc16);
+  return status[1];
+}
+
+void test_DecodeParallel(void)
+{
+  for (uint32_t seed = 1; seed <= 8; seed++)
+  {
+    TC_BuildStream(seed);
+    TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, TC_CompareWithBatch(TC_FRAMES_CNT));
+  }
+}
+
+void test_DecodeParallelFramesExhausted(void)
+{
+  TC_BuildStream(11);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_OVERFLOW, TC_CompareWithBatch(TC_FRAMES_CNT / 64));
+}
+
+void test_DecodeParallelMaxFrameLen(void)
+{
+  TC_Config.max_frame_len = 300;
+
+  for (uint32_t seed = 1; seed <= 8; seed++)
+  {
+    TC_BuildStream(seed);
+    TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, TC_CompareWithBatch(TC_FRAMES_CNT));
+  }
+}
+
+void test_DecodeParallelDiscardAtSplit(void)
+{
+  uint8_t       frame[16];
+  size_t        frame_len;
+  uint8_t       payload[3] = {0x11, 0x00, 0x00};
+  size_t        stream_len = 2 * STX_ETX_PARALLEL_MIN_CHUNK_LEN;
+
+  TC_Config.max_frame_len = 8;
+
+  /* Frame without escapes ending with STX as the second CRC byte. */
+  for (uint32_t value = 0; value <= UINT16_MAX; value++)
+  {
+    STX_ETX_t stx_etx;
+    STX_ETX_Init(&stx_etx, &TC_Config);
+
+    size_t in_len = sizeof(payload);
+
+    payload[1] = (uint8_t)(value >> 8);
+    payload[2] = (uint8_t)value;
+    frame_len  = sizeof(frame);
+    STX_ETX_Encode(&stx_etx, payload, &in_len, frame, &frame_len);
+
+    if ((STX == frame[frame_len - 1]) && (frame_len == sizeof(payload) + 4))
+    {
+      break;
+    }
+  }
+  TEST_ASSERT_EQUAL_HEX8(STX, frame[frame_len - 1]);
+
+  /* Frames and padding garbage, so that the chunk split of two threads lands just after STX of
+   * that frame. The speculative decoder starts at its CRC byte, drops following garbage as too long
+   * frame and resumes discarding, while the serial decoder reports the garbage as invalid characters. */
+  size_t split = stream_len / 2;
+
+  TC_StreamLen = 0;
+
+  while (TC_StreamLen + 2 * frame_len < split)
+  {
+    memcpy(&TC_Stream[TC_StreamLen], frame, frame_len);
+    TC_StreamLen += frame_len;
+  }
+
+  memset(&TC_Stream[TC_StreamLen], 0x55, split - 1 - TC_StreamLen);
+  TC_StreamLen = split - 1;
+  memcpy(&TC_Stream[TC_StreamLen], frame, frame_len);
+  TC_StreamLen += frame_len;
+  memset(&TC_Stream[TC_StreamLen], 0x55, 12);
+  TC_StreamLen += 12;
+
+  while (TC_StreamLen + frame_len < stream_len)
+  {
+    memcpy(&TC_Stream[TC_StreamLen], frame, frame_len);
+    TC_StreamLen += frame_len;
+  }
+
+  memset(&TC_Stream[TC_StreamLen], 0x55, stream_len - TC_StreamLen);
+  TC_StreamLen = stream_len;
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_INV_CHAR, TC_CompareWithBatch(TC_FRAMES_CNT));
+}
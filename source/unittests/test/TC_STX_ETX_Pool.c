@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "STX_ETX.h"
+#include "STX_ETX_Pool.h"
+
+#include "unity.h"
+
+
+#define TC_THREADS_CNT  4
+#define TC_ROUNDS_CNT   20000
+
+static const STX_ETX_Config_t          TC_ConfigNoCRC = {0};
+static const STX_ETX_PoolClassConfig_t TC_Classes[] =
+{
+  {64,   8},
+  {256,  4},
+  {4096, 2},
+};
+
+static STX_ETX_Pool_t TC_Pool;
+static uint8_t        TC_Storage[8 * (64 + 64) + 4 * (64 + 256) + 2 * (64 + 4096)] __attribute__((aligned(STX_ETX_POOL_CACHE_LINE)));
+
+void setUp(void)
+{
+  TEST_ASSERT_EQUAL(sizeof(TC_Storage), STX_ETX_Pool_StorageSize(TC_Classes, 3));
+  TEST_ASSERT_TRUE(STX_ETX_Pool_Init(&TC_Pool, TC_Storage, sizeof(TC_Storage), TC_Classes, 3));
+}
+
+void tearDown(void)
+{
+
+}
+
+static size_t TC_CountFree(size_t capacity)
+{
+  STX_ETX_PoolFrame_t * frames[16];
+  size_t                frames_cnt = 0;
+
+  while (NULL != (frames[frames_cnt] = STX_ETX_Pool_Alloc(&TC_Pool, capacity)))
+  {
+    frames_cnt++;
+  }
+
+  for (size_t i = 0; i < frames_cnt; i++)
+  {
+    STX_ETX_Pool_Release(frames[i]);
+  }
+  return frames_cnt;
+}
+
+void test_PoolAlloc(void)
+{
+  STX_ETX_PoolFrame_t * p_frame = STX_ETX_Pool_Alloc(&TC_Pool, 100);
+
+  TEST_ASSERT_NOT_NULL(p_frame);
+  TEST_ASSERT_EQUAL(256, p_frame->capacity);
+  TEST_ASSERT_EQUAL(0, (uintptr_t)p_frame->p_data % STX_ETX_POOL_CACHE_LINE);
+
+  /* Frame returns to pool with the last reference. */
+  STX_ETX_Pool_Retain(p_frame);
+  STX_ETX_Pool_Release(p_frame);
+  TEST_ASSERT_EQUAL(3 + 2, TC_CountFree(100));
+
+  STX_ETX_Pool_Release(p_frame);
+  TEST_ASSERT_EQUAL(4 + 2, TC_CountFree(100));
+
+  TEST_ASSERT_NULL(STX_ETX_Pool_Alloc(&TC_Pool, 5000));
+}
+
+void test_DecodeToPool(void)
+{
+  STX_ETX_t             stx_etx;
+  STX_ETX_PoolFrame_t * p_frame = NULL;
+  uint8_t               payload[1000];
+  uint8_t               encoded[2 * sizeof(payload) + 8];
+  size_t                payload_len = sizeof(payload);
+  size_t                encoded_len = sizeof(encoded);
+
+  for (size_t i = 0; i < sizeof(payload); i++)
+  {
+    payload[i] = (uint8_t)i;
+  }
+
+  STX_ETX_Init(&stx_etx, &TC_ConfigNoCRC);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Encode(&stx_etx, payload, &payload_len, encoded, &encoded_len));
+
+  /* Frame is moved from 64 B to 4 KiB class, while it is decoded in two calls. */
+  size_t           in_len = 100;
+  STX_ETX_Status_t status = STX_ETX_DecodeToPool(&stx_etx, encoded, &in_len, &TC_Pool, &p_frame);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, status);
+  TEST_ASSERT_NOT_NULL(p_frame);
+  TEST_ASSERT_EQUAL(256, p_frame->capacity);
+
+  size_t in_offset = in_len;
+
+  in_len = encoded_len - in_offset;
+  status = STX_ETX_DecodeToPool(&stx_etx, &encoded[in_offset], &in_len, &TC_Pool, &p_frame);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+  TEST_ASSERT_EQUAL(4096, p_frame->capacity);
+  TEST_ASSERT_EQUAL(sizeof(payload), p_frame->len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(payload, p_frame->p_data, sizeof(payload));
+  TEST_ASSERT_EQUAL(8 + 4 + 1, TC_CountFree(1));
+
+  /* Frame is shared by two consumers. */
+  STX_ETX_Pool_Retain(p_frame);
+  STX_ETX_Pool_Release(p_frame);
+  TEST_ASSERT_EQUAL(1, TC_CountFree(4096));
+  STX_ETX_Pool_Release(p_frame);
+  TEST_ASSERT_EQUAL(2, TC_CountFree(4096));
+
+  /* Invalid frame is released. */
+  const uint8_t invalid[] = {STX, 0x00, STX};
+
+  p_frame = NULL;
+  in_len  = sizeof(invalid);
+  status  = STX_ETX_DecodeToPool(&stx_etx, invalid, &in_len, &TC_Pool, &p_frame);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_INV_CHAR, status);
+  TEST_ASSERT_NULL(p_frame);
+  TEST_ASSERT_EQUAL(8 + 4 + 2, TC_CountFree(1));
+}
+
+static void * TC_Worker(void * p_arg)
+{
+  STX_ETX_PoolFrame_t ** pp_shared = (STX_ETX_PoolFrame_t **)p_arg;
+
+  for (size_t round = 0; round < TC_ROUNDS_CNT; round++)
+  {
+    STX_ETX_PoolFrame_t * p_frame = STX_ETX_Pool_Alloc(&TC_Pool, 1);
+
+    if (NULL != p_frame)
+    {
+      /* Frame is handed over to another thread through shared slot. */
+      p_frame->p_data[0] = (uint8_t)round;
+      p_frame            = __atomic_exchange_n(pp_shared, p_frame, __ATOMIC_ACQ_REL);
+    }
+
+    if (NULL != p_frame)
+    {
+      STX_ETX_Pool_Release(p_frame);
+    }
+  }
+  return NULL;
+}
+
+void test_PoolThreads(void)
+{
+  pthread_t             threads[TC_THREADS_CNT];
+  STX_ETX_PoolFrame_t * p_shared = NULL;
+
+  for (size_t i = 0; i < TC_THREADS_CNT; i++)
+  {
+    TEST_ASSERT_EQUAL(0, pthread_create(&threads[i], NULL, TC_Worker, &p_shared));
+  }
+
+  for (size_t i = 0; i < TC_THREADS_CNT; i++)
+  {
+    pthread_join(threads[i], NULL);
+  }
+
+  if (NULL != p_shared)
+  {
+    STX_ETX_Pool_Release(p_shared);
+  }
+
+  TEST_ASSERT_EQUAL(8 + 4 + 2, TC_CountFree(1));
+}
@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "STX_ETX.h"
+#include "STX_ETX_Ring.h"
+
+#include "unity.h"
+
+
+#define TC_SLOTS_CNT    4
+#define TC_SLOT_SIZE    64
+#define TC_FRAMES_CNT   20000
+
+static const STX_ETX_Config_t TC_ConfigNoCRC = {0};
+
+static STX_ETX_ByteRing_t  TC_ByteRing;
+static STX_ETX_FrameRing_t TC_FrameRing;
+static uint8_t             TC_ByteBuf[16];
+static size_t              TC_FrameStorage[STX_ETX_FRAME_RING_STORAGE_SIZE(TC_SLOTS_CNT, TC_SLOT_SIZE) / sizeof(size_t)];
+
+static bool                TC_ProducerDone;
+
+void setUp(void)
+{
+  TEST_ASSERT_TRUE(STX_ETX_ByteRing_Init(&TC_ByteRing, TC_ByteBuf, sizeof(TC_ByteBuf)));
+  TEST_ASSERT_TRUE(STX_ETX_FrameRing_Init(&TC_FrameRing, TC_FrameStorage, TC_SLOTS_CNT, TC_SLOT_SIZE));
+}
+
+void tearDown(void)
+{
+
+}
+
+static size_t TC_EncodeFrame(uint32_t index, uint8_t * p_out, size_t out_len)
+{
+  uint8_t payload[TC_SLOT_SIZE];
+  size_t  payload_len = index % (TC_SLOT_SIZE / 2);
+
+  for (size_t i = 0; i < payload_len; i++)
+  {
+    payload[i] = (uint8_t)(index + i);
+  }
+
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigNoCRC);
+  STX_ETX_Encode(&stx_etx, payload, &payload_len, p_out, &out_len);
+  return out_len;
+}
+
+static void * TC_Producer(void * p_arg)
+{
+  uint8_t encoded[2 * TC_SLOT_SIZE];
+
+  (void)p_arg;
+
+  for (uint32_t index = 0; index < TC_FRAMES_CNT; index++)
+  {
+    size_t encoded_len = TC_EncodeFrame(index, encoded, sizeof(encoded));
+    size_t written_len = 0;
+
+    while (written_len < encoded_len)
+    {
+      size_t len = STX_ETX_ByteRing_Write(&TC_ByteRing, &encoded[written_len], encoded_len - written_len);
+
+      if (0 == len)
+      {
+        sched_yield();
+      }
+      written_len += len;
+    }
+  }
+  return NULL;
+}
+
+static void * TC_Decoder(void * p_arg)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigNoCRC);
+
+  while (!__atomic_load_n(&TC_ProducerDone, __ATOMIC_ACQUIRE) ||
+         (__atomic_load_n(&TC_ByteRing.head, __ATOMIC_ACQUIRE) != TC_ByteRing.tail))
+  {
+    STX_ETX_Ring_DecodeFrames(&stx_etx, &TC_ByteRing, &TC_FrameRing);
+    sched_yield();
+  }
+
+  *(STX_ETX_State_t *)p_arg = stx_etx.state;
+  return NULL;
+}
+
+void test_ByteRingDecodeWraparound(void)
+{
+  const uint8_t encoded[]  = {STX, 0x00, 0x01, DLE, ETX, 0x04, 0x05, 0x06, 0x07, 0x08, ETX};
+  const uint8_t expected[] = {0x00, 0x01, ETX, 0x04, 0x05, 0x06, 0x07, 0x08};
+
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigNoCRC);
+
+  for (size_t round = 0; round < 3; round++)
+  {
+    uint8_t decoded[sizeof(expected)];
+    size_t  decoded_len = sizeof(decoded);
+
+    TEST_ASSERT_EQUAL(sizeof(encoded), STX_ETX_ByteRing_Write(&TC_ByteRing, encoded, sizeof(encoded)));
+
+    STX_ETX_Status_t status = STX_ETX_ByteRing_Decode(&stx_etx, &TC_ByteRing, decoded, &decoded_len);
+
+    TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, status);
+    TEST_ASSERT_EQUAL(sizeof(expected), decoded_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, decoded, decoded_len);
+    TEST_ASSERT_EQUAL(TC_ByteRing.head, TC_ByteRing.tail);
+  }
+}
+
+void test_ByteRingFull(void)
+{
+  uint8_t data[sizeof(TC_ByteBuf) + 1] = {0};
+
+  TEST_ASSERT_EQUAL(sizeof(TC_ByteBuf), STX_ETX_ByteRing_Write(&TC_ByteRing, data, sizeof(data)));
+  TEST_ASSERT_EQUAL(0, STX_ETX_ByteRing_Write(&TC_ByteRing, data, sizeof(data)));
+}
+
+void test_DecodeFramesOverflow(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigNoCRC);
+
+  const uint8_t encoded[] = {STX, 0x11, ETX, STX, 0x12, ETX, STX, 0x13, ETX, STX, 0x14, ETX, STX, 0x15};
+
+  TEST_ASSERT_EQUAL(sizeof(encoded), STX_ETX_ByteRing_Write(&TC_ByteRing, encoded, sizeof(encoded)));
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_OVERFLOW, STX_ETX_Ring_DecodeFrames(&stx_etx, &TC_ByteRing, &TC_FrameRing));
+
+  size_t          frame_len;
+  uint8_t const * p_frame = STX_ETX_FrameRing_Peek(&TC_FrameRing, &frame_len);
+
+  TEST_ASSERT_NOT_NULL(p_frame);
+  TEST_ASSERT_EQUAL(1, frame_len);
+  TEST_ASSERT_EQUAL_HEX8(0x11, p_frame[0]);
+  STX_ETX_FrameRing_Release(&TC_FrameRing);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, STX_ETX_Ring_DecodeFrames(&stx_etx, &TC_ByteRing, &TC_FrameRing));
+  TEST_ASSERT_EQUAL(STX_ETX_STATE_STARTED, stx_etx.state);
+
+  for (uint8_t value = 0x12; value <= 0x14; value++)
+  {
+    p_frame = STX_ETX_FrameRing_Peek(&TC_FrameRing, &frame_len);
+
+    TEST_ASSERT_NOT_NULL(p_frame);
+    TEST_ASSERT_EQUAL(1, frame_len);
+    TEST_ASSERT_EQUAL_HEX8(value, p_frame[0]);
+    STX_ETX_FrameRing_Release(&TC_FrameRing);
+  }
+
+  TEST_ASSERT_NULL(STX_ETX_FrameRing_Peek(&TC_FrameRing, &frame_len));
+}
+
+void test_DecodeFramesThreads(void)
+{
+  pthread_t       producer;
+  pthread_t       decoder;
+  STX_ETX_State_t decoder_state = STX_ETX_STATE_STARTED;
+
+  TC_ProducerDone = false;
+  TEST_ASSERT_EQUAL(0, pthread_create(&producer, NULL, TC_Producer, NULL));
+  TEST_ASSERT_EQUAL(0, pthread_create(&decoder, NULL, TC_Decoder, &decoder_state));
+
+  for (uint32_t index = 0; index < TC_FRAMES_CNT; index++)
+  {
+    size_t          frame_len;
+    uint8_t const * p_frame;
+
+    while (NULL == (p_frame = STX_ETX_FrameRing_Peek(&TC_FrameRing, &frame_len)))
+    {
+      sched_yield();
+    }
+
+    size_t payload_len = index % (TC_SLOT_SIZE / 2);
+
+    TEST_ASSERT_EQUAL(payload_len, frame_len);
+    for (size_t i = 0; i < payload_len; i++)
+    {
+      TEST_ASSERT_EQUAL_HEX8((uint8_t)(index + i), p_frame[i]);
+    }
+    STX_ETX_FrameRing_Release(&TC_FrameRing);
+  }
+
+  pthread_join(producer, NULL);
+  __atomic_store_n(&TC_ProducerDone, true, __ATOMIC_RELEASE);
+  pthread_join(decoder, NULL);
+
+  TEST_ASSERT_EQUAL(STX_ETX_STATE_IDLE, decoder_state);
+}
@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "STX_ETX.h"
+#include "STX_ETX_CRC.h"
+#include "STX_ETX_Source.h"
+
+#include "unity.h"
+
+
+#define TC_FRAME_SIZE  8
+
+static STX_ETX_Config_t TC_Config;
+static STX_ETX_Source_t TC_Source;
+static uint8_t          TC_Frame[TC_FRAME_SIZE];
+
+void setUp(void)
+{
+  TEST_ASSERT_TRUE(STX_ETX_CRC16_GetConfig(STX_ETX_CRC16_XMODEM, &TC_Config));
+  STX_ETX_Source_Init(&TC_Source, &TC_Config, TC_Frame, sizeof(TC_Frame));
+}
+
+void tearDown(void)
+{
+
+}
+
+static size_t TC_EncodeFrame(uint8_t const * p_payload, size_t payload_len, uint8_t * p_out, size_t out_len)
+{
+  STX_ETX_t stx_etx;
+
+  STX_ETX_Init(&stx_etx, &TC_Config);
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Encode(&stx_etx, p_payload, &payload_len, p_out, &out_len));
+  return out_len;
+}
+
+static void TC_DecodeFrame(uint8_t const * p_in, size_t in_len, uint8_t const * p_payload, size_t payload_len)
+{
+  size_t len = in_len;
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Source_Decode(&TC_Source, p_in, &len));
+  TEST_ASSERT_EQUAL(in_len, len);
+  TEST_ASSERT_EQUAL(payload_len, TC_Source.frame_len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(p_payload, TC_Frame, payload_len);
+}
+
+void test_SourceSplitFrames(void)
+{
+  const uint8_t payload[] = {0x01, STX, 0x20, ETX, DLE, 0x30};
+  uint8_t       encoded[2 * (2 * sizeof(payload) + 8)];
+  size_t        frame_len   = TC_EncodeFrame(payload, sizeof(payload), encoded, sizeof(encoded));
+  size_t        encoded_len = frame_len + TC_EncodeFrame(payload, 2, &encoded[frame_len], sizeof(encoded) - frame_len);
+
+  /* Frame split at every byte is continued in frame buffer. */
+  for (size_t index = 0; index < frame_len - 1; index++)
+  {
+    size_t len = 1;
+
+    TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, STX_ETX_Source_Decode(&TC_Source, &encoded[index], &len));
+    TEST_ASSERT_EQUAL(1, len);
+  }
+  TC_DecodeFrame(&encoded[frame_len - 1], 1, payload, sizeof(payload));
+
+  /* Decoding stops after each frame, the rest is decoded by next call. */
+  size_t len = encoded_len;
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Source_Decode(&TC_Source, encoded, &len));
+  TEST_ASSERT_EQUAL(frame_len, len);
+  TEST_ASSERT_EQUAL(sizeof(payload), TC_Source.frame_len);
+  TC_DecodeFrame(&encoded[frame_len], encoded_len - frame_len, payload, 2);
+}
+
+void test_SourceResync(void)
+{
+  const uint8_t payload[] = {0x11, 0x22, 0x33};
+  const uint8_t garbage[] = {0x55, STX, 0x01, 0x05, STX};
+  uint8_t       encoded[2 * sizeof(payload) + 8];
+  size_t        encoded_len = TC_EncodeFrame(payload, sizeof(payload), encoded, sizeof(encoded));
+
+  /* Garbage and invalid frame are skipped, dropped frame does not leak into the next one. */
+  size_t len = sizeof(garbage) - 1;
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, STX_ETX_Source_Decode(&TC_Source, garbage, &len));
+  TEST_ASSERT_EQUAL(sizeof(garbage) - 1, len);
+  TEST_ASSERT_EQUAL(2, TC_Source.frame_len);
+
+  uint8_t stream[sizeof(encoded)];
+
+  stream[0] = STX;
+  memcpy(&stream[1], &encoded[1], encoded_len - 1);
+  TC_DecodeFrame(stream, encoded_len, payload, sizeof(payload));
+
+  TEST_ASSERT_EQUAL(1, TC_Source.resync.inv_char_cnt);
+  TEST_ASSERT_EQUAL(1, TC_Source.resync.skipped_len);
+}
+
+void test_SourceTooLong(void)
+{
+  const uint8_t payload[TC_FRAME_SIZE + 1] = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18};
+  uint8_t       encoded[2 * sizeof(payload) + 8];
+  size_t        encoded_len = TC_EncodeFrame(payload, sizeof(payload), encoded, sizeof(encoded));
+  size_t        len         = encoded_len;
+
+  /* Frame longer than frame buffer is skipped. */
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, STX_ETX_Source_Decode(&TC_Source, encoded, &len));
+  TEST_ASSERT_EQUAL(encoded_len, len);
+  TEST_ASSERT_EQUAL(1, TC_Source.resync.too_long_cnt);
+
+  /* Frame filling whole frame buffer fits. */
+  encoded_len = TC_EncodeFrame(payload, TC_FRAME_SIZE, encoded, sizeof(encoded));
+  TC_DecodeFrame(encoded, encoded_len, payload, TC_FRAME_SIZE);
+
+  /* Shorter limit of configuration is kept. */
+  TC_Config.max_frame_len = 4;
+  STX_ETX_Source_Init(&TC_Source, &TC_Config, TC_Frame, sizeof(TC_Frame));
+
+  len = encoded_len;
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, STX_ETX_Source_Decode(&TC_Source, encoded, &len));
+  TEST_ASSERT_EQUAL(1, TC_Source.resync.too_long_cnt);
+}
+
+void test_SourceDropAfterPartialFrame(void)
+{
+  const uint8_t payload[TC_FRAME_SIZE] = {0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27};
+  uint8_t       encoded[2 + 2 * sizeof(payload) + 8];
+  size_t        encoded_len;
+
+  /* Frame in progress fills most of frame buffer, it is dropped by STX and
+   * the new one, written after it, is moved to the beginning of frame buffer. */
+  encoded[0] = STX;
+  memcpy(&encoded[1], payload, TC_FRAME_SIZE - 1);
+
+  size_t len = TC_FRAME_SIZE;
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_CONTINUE, STX_ETX_Source_Decode(&TC_Source, encoded, &len));
+  TEST_ASSERT_EQUAL(TC_FRAME_SIZE - 1, TC_Source.frame_len);
+
+  encoded_len = TC_EncodeFrame(payload, sizeof(payload), encoded, sizeof(encoded));
+  TC_DecodeFrame(encoded, encoded_len, payload, sizeof(payload));
+
+  TEST_ASSERT_EQUAL(1, TC_Source.resync.inv_char_cnt);
+  TEST_ASSERT_EQUAL(0, TC_Source.resync.too_long_cnt);
+}
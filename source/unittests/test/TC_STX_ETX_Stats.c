@@ -0,0 +1,214 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "STX_ETX.h"
+#include "STX_ETX_CRC.h"
+#include "STX_ETX_Channels.h"
+
+#include "unity.h"
+
+
+static STX_ETX_Config_t TC_ConfigCRC;
+static STX_ETX_Stats_t  TC_Stats;
+
+void setUp(void)
+{
+  STX_ETX_CRC16_GetConfig(STX_ETX_CRC16_XMODEM, &TC_ConfigCRC);
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_StatsEncode(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+  STX_ETX_StatsAttach(&stx_etx, &TC_Stats);
+
+  const uint8_t data[] = {0x00, STX, 0x01, DLE, 0x04};
+
+  uint8_t                 encoded[32];
+  STX_ETX_StatsCounters_t counters;
+
+  size_t data_len    = sizeof(data);
+  size_t encoded_len = 4;
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_OVERFLOW, STX_ETX_Encode(&stx_etx, data, &data_len, encoded, &encoded_len));
+
+  size_t offset = data_len;
+
+  data_len    = sizeof(data) - offset;
+  encoded_len = sizeof(encoded);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Encode(&stx_etx, &data[offset], &data_len, encoded, &encoded_len));
+
+  STX_ETX_StatsSnapshot(&TC_Stats, &counters);
+  TEST_ASSERT_EQUAL(1, counters.frames_encoded);
+  TEST_ASSERT_EQUAL(sizeof(data), counters.payload_encoded);
+  TEST_ASSERT_EQUAL(2, counters.escapes_encoded);
+  TEST_ASSERT_EQUAL(1, counters.overflow_cnt);
+  TEST_ASSERT_EQUAL(0, counters.frames_decoded);
+}
+
+void test_StatsDecode(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+  STX_ETX_StatsAttach(&stx_etx, &TC_Stats);
+
+  const uint8_t data[] = {0x00, STX, 0x01, DLE, 0x04};
+
+  uint8_t                 encoded[64];
+  uint8_t                 decoded[64];
+  STX_ETX_Frame_t         frames[8];
+  STX_ETX_StatsCounters_t counters;
+
+  STX_ETX_t encoder;
+  STX_ETX_Init(&encoder, &TC_ConfigCRC);
+
+  size_t data_len    = sizeof(data);
+  size_t frame_len   = sizeof(encoded) / 2;
+
+  encoded[0] = 0xFF;
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Encode(&encoder, data, &data_len, &encoded[1], &frame_len));
+
+  /* Second copy has corrupted CRC. */
+  memcpy(&encoded[1 + frame_len], &encoded[1], frame_len);
+  encoded[2 * frame_len] ^= 0x01;
+
+  size_t encoded_len = 1 + 2 * frame_len;
+  size_t decoded_len = sizeof(decoded);
+  size_t frames_cnt  = sizeof(frames) / sizeof(frames[0]);
+
+  STX_ETX_DecodeBatch(&stx_etx, encoded, &encoded_len, decoded, &decoded_len, frames, &frames_cnt);
+
+  TEST_ASSERT_EQUAL(3, frames_cnt);
+  STX_ETX_StatsSnapshot(&TC_Stats, &counters);
+  TEST_ASSERT_EQUAL(1, counters.frames_decoded);
+  TEST_ASSERT_EQUAL(2 * sizeof(data), counters.payload_decoded);
+  TEST_ASSERT_EQUAL(4, counters.escapes_decoded);
+  TEST_ASSERT_EQUAL(1, counters.inv_crc_cnt);
+  TEST_ASSERT_EQUAL(1, counters.inv_char_cnt);
+  TEST_ASSERT_EQUAL(1, counters.idle_discarded);
+
+  STX_ETX_StatsReset(&TC_Stats);
+
+  encoded_len = frame_len;
+  decoded_len = 2;
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_OVERFLOW, STX_ETX_Decode(&stx_etx, &encoded[1], &encoded_len, decoded, &decoded_len));
+
+  STX_ETX_StatsSnapshot(&TC_Stats, &counters);
+  TEST_ASSERT_EQUAL(0, counters.frames_decoded);
+  TEST_ASSERT_EQUAL(2, counters.payload_decoded);
+  TEST_ASSERT_EQUAL(1, counters.escapes_decoded);
+  TEST_ASSERT_EQUAL(1, counters.overflow_cnt);
+  TEST_ASSERT_EQUAL(0, counters.inv_crc_cnt);
+}
+
+void test_StatsDecodeView(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+  STX_ETX_StatsAttach(&stx_etx, &TC_Stats);
+
+  const uint8_t data[] = {0x00, 0x01, 0x04};
+
+  uint8_t                 encoded[16];
+  uint8_t                 decoded[16];
+  uint8_t const *         p_data;
+  STX_ETX_StatsCounters_t counters;
+
+  STX_ETX_t encoder;
+  STX_ETX_Init(&encoder, &TC_ConfigCRC);
+
+  size_t data_len    = sizeof(data);
+  size_t encoded_len = sizeof(encoded);
+  size_t decoded_len = sizeof(decoded);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Encode(&encoder, data, &data_len, encoded, &encoded_len));
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE,
+                         STX_ETX_DecodeView(&stx_etx, encoded, &encoded_len, decoded, &decoded_len, &p_data, &data_len));
+
+  STX_ETX_StatsSnapshot(&TC_Stats, &counters);
+  TEST_ASSERT_EQUAL(1, counters.frames_decoded);
+  TEST_ASSERT_EQUAL(sizeof(data), counters.payload_decoded);
+}
+
+void test_StatsChannels(void)
+{
+  STX_ETX_Channels_t channels;
+  uint32_t           storage[STX_ETX_CHANNELS_STORAGE_SIZE(2) / sizeof(uint32_t)];
+
+  STX_ETX_Channels_Init(&channels, storage, 2, &TC_ConfigCRC);
+  STX_ETX_Channels_StatsAttach(&channels, &TC_Stats);
+
+  const uint8_t data[] = {0x00, 0x01, 0x04};
+
+  uint8_t                 encoded[16];
+  uint8_t                 decoded[16];
+  STX_ETX_ChannelFrame_t  frames[4];
+  STX_ETX_StatsCounters_t counters;
+
+  STX_ETX_t encoder;
+  STX_ETX_Init(&encoder, &TC_ConfigCRC);
+
+  size_t data_len    = sizeof(data);
+  size_t encoded_len = sizeof(encoded);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE, STX_ETX_Encode(&encoder, data, &data_len, encoded, &encoded_len));
+
+  STX_ETX_Chunk_t chunks[] =
+  {
+    {0, encoded,     2},
+    {1, encoded,     encoded_len},
+    {0, &encoded[2], encoded_len - 2},
+  };
+
+  size_t chunks_cnt  = sizeof(chunks) / sizeof(chunks[0]);
+  size_t in_offset   = 0;
+  size_t decoded_len = sizeof(decoded);
+  size_t frames_cnt  = sizeof(frames) / sizeof(frames[0]);
+
+  TEST_ASSERT_EQUAL_HEX8(STX_ETX_STATUS_DONE,
+                         STX_ETX_Channels_DecodeBatch(&channels, chunks, &chunks_cnt, &in_offset,
+                                                      decoded, &decoded_len, frames, &frames_cnt));
+
+  STX_ETX_StatsSnapshot(&TC_Stats, &counters);
+  TEST_ASSERT_EQUAL(2, counters.frames_decoded);
+  TEST_ASSERT_EQUAL(2 * sizeof(data), counters.payload_decoded);
+}
+
+void test_StatsDecodeTable(void)
+{
+  STX_ETX_t stx_etx;
+  STX_ETX_Init(&stx_etx, &TC_ConfigCRC);
+  STX_ETX_StatsAttach(&stx_etx, &TC_Stats);
+
+  const uint8_t encoded[] = {0xFF,
+                             STX, 0x00, DLE, STX, 0x01, DLE, DLE, ETX, 0x00, 0x00,
+                             STX, 0x00, ETX};
+
+  uint8_t                 decoded[16];
+  STX_ETX_StatsCounters_t counters;
+  size_t                  in_index = 0;
+
+  while (in_index < sizeof(encoded))
+  {
+    size_t encoded_len = sizeof(encoded) - in_index;
+    size_t decoded_len = sizeof(decoded);
+
+    STX_ETX_DecodeTable(&stx_etx, &encoded[in_index], &encoded_len, decoded, &decoded_len);
+    in_index += encoded_len;
+  }
+
+  STX_ETX_StatsSnapshot(&TC_Stats, &counters);
+  TEST_ASSERT_EQUAL(0, counters.frames_decoded);
+  TEST_ASSERT_EQUAL(4 + 1, counters.payload_decoded);
+  TEST_ASSERT_EQUAL(2, counters.escapes_decoded);
+  TEST_ASSERT_EQUAL(1, counters.inv_crc_cnt);
+  TEST_ASSERT_EQUAL(1, counters.inv_char_cnt);
+  TEST_ASSERT_EQUAL(1, counters.idle_discarded);
+}